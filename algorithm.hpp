@@ -0,0 +1,1054 @@
+#ifndef __ALGORITHM_HPP
+#define __ALGORITHM_HPP 1
+
+#include "util.hpp"
+#include "object.hpp"
+#include "comporator.hpp"
+#include "execution.hpp"
+#include "pair.hpp"
+#include <memory>
+#include <cstring>
+#include <cstdint>
+
+#if _HAS_CXX20
+#include <bit>
+#endif // _HAS_CXX20
+
+#if defined(_M_IX86) || defined(_M_X64)
+#include <xmmintrin.h>
+#endif
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif // __AVX2__
+
+struct algorithms {
+protected:
+    /**
+    * adapts a three-way ordering functor to a strict weak "less"
+    */
+    template<class Comp> struct _ordered {
+        Comp& comp;
+
+        template<class L, class R> constexpr bool operator()(L const& l, R const& r) const {
+            return util::invoke(comp, l, r) < 0;
+        }
+    };
+
+    template<class Comp> constexpr static _ordered<Comp> _less(Comp& comp) noexcept { return { comp }; }
+
+    template<class EqualTo, class Less> constexpr static Less const& _less(comporator<EqualTo, Less>& comp) noexcept { return comp.less_than(); }
+
+    template<class EqualTo, class Less> constexpr static Less const& _less(comporator<EqualTo, Less> const& comp) noexcept { return comp.less_than(); }
+
+    template<class Comp> constexpr _INLINE_VAR static bool _natural_order_v =
+        is_same_v<remove_cvref_t<Comp>, comporator<void, less>> || is_same_v<remove_cvref_t<Comp>, comporator<equal_to, less>> || is_same_v<remove_cvref_t<Comp>, default_comporator>;
+
+    constexpr _INLINE_VAR static ptrdiff_t _insertion_threshold = 16;
+
+    constexpr _INLINE_VAR static ptrdiff_t _merge_threshold = 32;
+
+    constexpr _INLINE_VAR static size_t _radix_threshold = size_t(1) << 10;
+
+    template<class T> struct _buffer {
+        explicit _buffer(size_t const size) : data(std::allocator<T>().allocate(size)), size(size) {}
+
+        _buffer(_buffer const&) = delete;
+
+        _buffer& operator=(_buffer const&) = delete;
+
+        ~_buffer() noexcept { std::allocator<T>().deallocate(data, size); }
+
+        T* const data;
+        size_t const size;
+    };
+
+    template<class T> constexpr static void _swap(T& l, T& r) {
+        T tmp = static_cast<T&&>(l);
+        l = static_cast<T&&>(r);
+        r = static_cast<T&&>(tmp);
+    }
+
+    template<class T> static void _put(T* dst, T& value, true_type) { new(dst) T(static_cast<T&&>(value)); }
+
+    template<class T> static void _put(T* dst, T& value, false_type) { *dst = static_cast<T&&>(value); }
+
+    template<class T, class Less> constexpr static void _insertion_sort(T* const first, T* const last, Less& less) {
+        if (first == last) return;
+        for (T* i = first + 1; i != last; ++i) {
+            T value = static_cast<T&&>(*i);
+            T* j = i;
+            if (less(value, *first)) {
+                for (; j != first; --j) *j = static_cast<T&&>(*(j - 1));
+            }
+            else {
+                for (; less(value, *(j - 1)); --j) *j = static_cast<T&&>(*(j - 1));
+            }
+            *j = static_cast<T&&>(value);
+        }
+    }
+
+    template<class T, class Less> constexpr static void _sift_down(T* const first, ptrdiff_t i, ptrdiff_t const n, Less& less) {
+        T value = static_cast<T&&>(first[i]);
+        for (ptrdiff_t child = 2 * i + 1; child < n; child = 2 * i + 1) {
+            if (child + 1 < n && less(first[child], first[child + 1])) ++child;
+            if (!less(value, first[child])) break;
+            first[i] = static_cast<T&&>(first[child]);
+            i = child;
+        }
+        first[i] = static_cast<T&&>(value);
+    }
+
+    template<class T, class Less> constexpr static void _heap_sort(T* const first, T* const last, Less& less) {
+        ptrdiff_t const n = last - first;
+        for (ptrdiff_t i = n / 2; i-- != 0;) _sift_down(first, i, n, less);
+        for (ptrdiff_t end = n - 1; end > 0; --end) {
+            _swap(first[0], first[end]);
+            _sift_down(first, 0, end, less);
+        }
+    }
+
+    template<class T, class Less> constexpr static void _median_to_first(T* const result, T* const a, T* const b, T* const c, Less& less) {
+        if (less(*a, *b)) {
+            if (less(*b, *c)) _swap(*result, *b);
+            else if (less(*a, *c)) _swap(*result, *c);
+            else _swap(*result, *a);
+        }
+        else if (less(*a, *c)) _swap(*result, *a);
+        else if (less(*b, *c)) _swap(*result, *c);
+        else _swap(*result, *b);
+    }
+
+    /**
+    * Hoare partition of [first, last) around *pivot, unguarded: the median of three bounds both scans
+    */
+    template<class T, class Less> constexpr static T* _partition(T* first, T* last, T* const pivot, Less& less) {
+        for (;;) {
+            while (less(*first, *pivot)) ++first;
+            --last;
+            while (less(*pivot, *last)) --last;
+            if (!(first < last)) return first;
+            _swap(*first, *last);
+            ++first;
+        }
+    }
+
+    template<class T, class Less> constexpr static void _intro_sort(T* const first, T* last, ptrdiff_t depth, Less& less) {
+        while (last - first > _insertion_threshold) {
+            if (depth == 0) {
+                _heap_sort(first, last, less);
+                return;
+            }
+            --depth;
+            _median_to_first(first, first + 1, first + (last - first) / 2, last - 1, less);
+            T* const cut = _partition(first + 1, last, first, less);
+            _intro_sort(cut, last, depth, less);
+            last = cut;
+        }
+        _insertion_sort(first, last, less);
+    }
+
+    template<class T, class Less> static void _merge_sort(T* const first, T* const last, T* const buffer, Less& less) {
+        ptrdiff_t const n = last - first;
+        if (n <= _merge_threshold) {
+            _insertion_sort(first, last, less);
+            return;
+        }
+        T* const mid = first + n / 2;
+        _merge_sort(first, mid, buffer, less);
+        _merge_sort(mid, last, buffer, less);
+        if (!less(*mid, *(mid - 1))) return;
+
+        T* end = buffer;
+        for (T* i = first; i != mid; ++i, ++end) new(end) T(static_cast<T&&>(*i));
+        T* l = buffer;
+        T* r = mid;
+        T* out = first;
+        while (l != end && r != last) *out++ = less(*r, *l) ? static_cast<T&&>(*r++) : static_cast<T&&>(*l++);
+        while (l != end) *out++ = static_cast<T&&>(*l++);
+        objects::destroy_range(buffer, end);
+    }
+
+    /**
+    * stable merge of the sorted runs [first, mid) and [mid, last) into dst
+    * @param [] construct - true_type if dst is raw storage
+    */
+    template<class T, class Less, class Construct> static void _merge(T* first, T* const mid, T* const last, T* dst, Less& less, Construct construct) {
+        T* r = mid;
+        while (first != mid && r != last) _put(dst++, less(*r, *first) ? *r++ : *first++, construct);
+        while (first != mid) _put(dst++, *first++, construct);
+        while (r != last) _put(dst++, *r++, construct);
+    }
+
+    template<class T> using _radix_key_t = conditional<sizeof(T) == 1, uint8_t, conditional<sizeof(T) == 2, uint16_t, conditional<sizeof(T) == 4, uint32_t, uint64_t>>>;
+
+    /**
+    * maps value to an unsigned key with the same order
+    */
+    template<class T> static _radix_key_t<T> _radix_key(T const value) noexcept {
+        using K = _radix_key_t<T>;
+        K key;
+        std::memcpy(&key, &value, sizeof(T));
+        K const sign = K(K(1) << (sizeof(T) * 8 - 1));
+        if (std::is_floating_point<T>::value) return (key & sign) ? K(~key) : K(key | sign);
+        if (std::is_signed<T>::value) return K(key ^ sign);
+        return key;
+    }
+
+    template<class T, class Less> constexpr static void _sort(T* const first, T* const last, Less& less) {
+        ptrdiff_t depth = 0;
+        for (ptrdiff_t n = last - first; n > 1; n >>= 1) depth += 2;
+        _intro_sort(first, last, depth, less);
+    }
+
+    template<class T, class Less> static void _stable_sort(T* const first, T* const last, Less& less) {
+        _buffer<T> const buffer(size_t(last - first) / 2);
+        _merge_sort(first, last, buffer.data, less);
+    }
+
+    template<class T> constexpr static bool _radix_sort(T* const first, T* const last, true_type) {
+        if (size_t(last - first) < _radix_threshold) return false;
+        radix_sort(first, last);
+        return true;
+    }
+
+    template<class T> constexpr static bool _radix_sort(T*, T*, false_type) noexcept { return false; }
+
+    /**
+    * sorts chunks in parallel with sort_chunk and merges them pairwise, each round in parallel
+    */
+    template<class Policy, class T, class Less, class SortChunk> static void _parallel_sort(Policy&& policy, T* const first, T* const last, Less& less, SortChunk sort_chunk) {
+        size_t const n = last - first;
+        size_t const runs = execution::chunks(n);
+        auto const bound = [n, runs](size_t const run) { return n * run / runs; };
+        execution::for_n(policy, runs, [&](size_t const i) { sort_chunk(first + bound(i), first + bound(i + 1)); });
+        if (runs < 2) return;
+
+        _buffer<T> const buffer(n);
+        T* src = first;
+        T* dst = buffer.data;
+        bool constructed = false;
+        for (size_t width = 1; width < runs; width *= 2) {
+            bool const raw = dst == buffer.data && !constructed;
+            execution::for_n(policy, (runs + 2 * width - 1) / (2 * width), [&](size_t const pair) {
+                size_t const lo = pair * 2 * width;
+                size_t const mid = lo + width < runs ? lo + width : runs;
+                size_t const hi = lo + 2 * width < runs ? lo + 2 * width : runs;
+                if (raw)
+                    _merge(src + bound(lo), src + bound(mid), src + bound(hi), dst + bound(lo), less, true_type{});
+                else
+                    _merge(src + bound(lo), src + bound(mid), src + bound(hi), dst + bound(lo), less, false_type{});
+            });
+            constructed = true;
+            T* const tmp = src;
+            src = dst;
+            dst = tmp;
+        }
+        if (src != first) {
+            execution::for_chunks(policy, n, [first, src](size_t const from, size_t const to) {
+                for (size_t i = from; i != to; ++i) first[i] = static_cast<T&&>(src[i]);
+            });
+        }
+        objects::destroy_range(buffer.data, buffer.data + n);
+    }
+
+    /**
+    * ranges longer than this are searched with prefetching
+    */
+    constexpr _INLINE_VAR static size_t _prefetch_threshold = 64;
+
+    /**
+    * the count of searches lower_bound_many runs side by side
+    */
+    constexpr _INLINE_VAR static size_t _interleave = 8;
+
+    static void _prefetch(void const* p) noexcept {
+#if defined(_M_IX86) || defined(_M_X64)
+        _mm_prefetch(static_cast<char const*>(p), _MM_HINT_T0);
+#elif defined(__GNUC__)
+        __builtin_prefetch(p);
+#endif
+    }
+
+    template<class U, class Less> struct _before {
+        U const& value;
+        Less& less;
+
+        template<class T> constexpr bool operator()(T const& elem) const { return less(elem, value); }
+    };
+
+    template<class U, class Less> struct _not_after {
+        U const& value;
+        Less& less;
+
+        template<class T> constexpr bool operator()(T const& elem) const { return !less(value, elem); }
+    };
+
+    /**
+    * branchless binary search of the first element for which pred is false,
+    * prefetching both candidate midpoints of the next step while the range is long
+    */
+    template<class T, class Pred> constexpr static size_t _partition_point(T const* const first, size_t n, Pred const& pred) {
+        if (n == 0) return 0;
+        T const* base = first;
+        for (; n > _prefetch_threshold; ) {
+            size_t const half = n / 2;
+            size_t const next = (n - half) / 2;
+            _prefetch(base + next);
+            _prefetch(base + half + next);
+            base = pred(base[half]) ? base + half : base;
+            n -= half;
+        }
+        for (; n > 1; ) {
+            size_t const half = n / 2;
+            base = pred(base[half]) ? base + half : base;
+            n -= half;
+        }
+        return size_t(base - first) + pred(*base);
+    }
+
+    /**
+    * the count of independent accumulators of the reduction kernels, written as plain lane loops for the vectorizer
+    */
+    constexpr _INLINE_VAR static size_t _lanes = 8;
+
+    /**
+    * any_of evaluates pred over blocks of this many elements before testing for a match
+    */
+    constexpr _INLINE_VAR static ptrdiff_t _any_block = 64;
+
+    /**
+    * the most multiply-adds of a product with fixed extents that the fixed kernels unroll
+    */
+    constexpr _INLINE_VAR static size_t _gemm_small = 4096;
+
+    template<class Pred> struct _not {
+        Pred& pred;
+
+        template<class T> constexpr bool operator()(T const& value) const { return !static_cast<bool>(util::invoke(pred, value)); }
+    };
+
+    template<class T> constexpr static auto _sum_block(T const* const first, size_t const n) {
+        sum_t<T> acc[_lanes]{};
+        size_t i = 0;
+        for (; i + _lanes <= n; i += _lanes) {
+            for (size_t j = 0; j != _lanes; ++j) acc[j] += first[i + j];
+        }
+        for (size_t j = 0; i != n; ++i, ++j) acc[j] += first[i];
+        for (size_t width = _lanes / 2; width != 0; width /= 2) {
+            for (size_t j = 0; j != width; ++j) acc[j] += acc[j + width];
+        }
+        return acc[0];
+    }
+
+    /**
+    * lane-wise selection, for arithmetic values where equal elements are indistinguishable
+    * @param [] n - not 0
+    */
+    template<class T, class Pick> constexpr static remove_cv_t<T> _select(T const* const first, size_t const n, Pick const& pick) {
+        remove_cv_t<T> acc[_lanes]{};
+        for (size_t j = 0; j != _lanes; ++j) acc[j] = first[j < n ? j : 0];
+        size_t i = _lanes < n ? _lanes : n;
+        for (; i + _lanes <= n; i += _lanes) {
+            for (size_t j = 0; j != _lanes; ++j) acc[j] = pick(first[i + j], acc[j]) ? first[i + j] : acc[j];
+        }
+        for (; i != n; ++i) acc[0] = pick(first[i], acc[0]) ? first[i] : acc[0];
+        for (size_t j = 1; j != _lanes; ++j) acc[0] = pick(acc[j], acc[0]) ? acc[j] : acc[0];
+        return acc[0];
+    }
+
+    template<class T, class Comp> constexpr static remove_cv_t<T> _min(T const* const first, size_t const n, Comp&, true_type) { return _select(first, n, less{}); }
+
+    template<class T, class Comp> constexpr static remove_cv_t<T> _min(T const* const first, size_t const n, Comp& comp, false_type) {
+        auto&& less = _less(comp);
+        T const* res = first;
+        for (T const* i = first + 1, *const end = first + n; i < end; ++i) res = less(*i, *res) ? i : res;
+        return *res;
+    }
+
+    template<class T, class Comp> constexpr static remove_cv_t<T> _max(T const* const first, size_t const n, Comp&, true_type) { return _select(first, n, greater{}); }
+
+    template<class T, class Comp> constexpr static remove_cv_t<T> _max(T const* const first, size_t const n, Comp& comp, false_type) {
+        auto&& less = _less(comp);
+        T const* res = first;
+        for (T const* i = first + 1, *const end = first + n; i < end; ++i) res = less(*res, *i) ? i : res;
+        return *res;
+    }
+
+    template<class T, class Comp> using _lanes_fit = conditional<std::is_arithmetic<remove_cv_t<T>>::value && _natural_order_v<Comp>>;
+
+    /**
+    * reduces [0, n) block by block (execution::grain elements each) and combines the partial results in order,
+    * so the result does not depend on the policy or the count of threads
+    * @param [] n - not 0
+    */
+    template<class R, class Policy, class Block, class Combine> static R _reduce_blocks(Policy&& policy, size_t const n, Block const& block, Combine const& combine) {
+        size_t const blocks = (n + execution::grain - 1) / execution::grain;
+        _buffer<R> const partials(blocks);
+        execution::for_n(policy, blocks, [&](size_t const i) {
+            size_t const from = i * execution::grain;
+            new(partials.data + i) R(block(from, n - from < execution::grain ? n : from + execution::grain));
+        });
+        R res = static_cast<R&&>(partials.data[0]);
+        for (size_t i = 1; i != blocks; ++i) res = combine(static_cast<R&&>(res), static_cast<R&&>(partials.data[i]));
+        objects::destroy_range(partials.data, partials.data + blocks);
+        return res;
+    }
+
+    /**
+    * copies first[i] for every set bit i of masks, starting from the bit from
+    */
+    template<class T> static remove_cv_t<T>* _compress_bits(T const* const first, size_t const n, uint64_t const* const masks, size_t const from, remove_cv_t<T>* dst) {
+        if (from == n) return dst;
+        T const* base = first + from;
+        uint64_t m = masks[from / 64] >> (from % 64);
+        for (size_t word = from / 64 + 1, words = (n + 63) / 64; ; ++word) {
+            for (; m; m &= m - 1) *dst++ = base[countr_zero(m)];
+            if (word == words) return dst;
+            base = first + word * 64;
+            m = masks[word];
+        }
+    }
+
+    template<class T> static remove_cv_t<T>* _compress(T const* const first, size_t const n, uint64_t const* const masks, remove_cv_t<T>* const dst, remove_cv_t<T>*, false_type) {
+        return _compress_bits(first, n, masks, 0, dst);
+    }
+
+#if defined(__AVX2__)
+    /**
+    * for every 8-bit mask, the indices of its set bits packed to the front
+    */
+    static uint32_t const (&_compress_indices() noexcept)[256][8] {
+        struct table {
+            alignas(32) uint32_t indices[256][8];
+
+            table() noexcept : indices() {
+                for (uint32_t m = 0; m != 256; ++m) {
+                    uint32_t k = 0;
+                    for (uint32_t j = 0; j != 8; ++j) {
+                        if (m >> j & 1) indices[m][k++] = j;
+                    }
+                }
+            }
+        };
+        static table const res;
+        return res.indices;
+    }
+
+    /**
+    * 4-byte elements: eight at a time through a permutation looked up by their 8-bit mask
+    */
+    template<class T> static remove_cv_t<T>* _compress(T const* const first, size_t const n, uint64_t const* const masks, remove_cv_t<T>* dst, remove_cv_t<T>* const dst_end, true_type) {
+        auto const& indices = _compress_indices();
+        size_t i = 0;
+        for (; i + 8 <= n && dst_end - dst >= 8; i += 8) {
+            unsigned const m = unsigned(masks[i / 64] >> (i % 64)) & 0xff;
+            __m256i const values = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(first + i));
+            __m256i const permutation = _mm256_load_si256(reinterpret_cast<__m256i const*>(indices[m]));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst), _mm256_permutevar8x32_epi32(values, permutation));
+            dst += popcount(m);
+        }
+        return _compress_bits(first, n, masks, i, dst);
+    }
+#else
+    template<class T> static remove_cv_t<T>* _compress(T const* const first, size_t const n, uint64_t const* const masks, remove_cv_t<T>* const dst, remove_cv_t<T>* const dst_end, true_type) {
+        return _compress(first, n, masks, dst, dst_end, false_type{});
+    }
+#endif // __AVX2__
+
+public:
+    static int popcount(uint64_t const x) noexcept {
+#if _HAS_CXX20
+        return std::popcount(x);
+#else
+        uint64_t v = x - ((x >> 1) & 0x5555555555555555ull);
+        v = (v & 0x3333333333333333ull) + ((v >> 2) & 0x3333333333333333ull);
+        v = (v + (v >> 4)) & 0x0f0f0f0f0f0f0f0full;
+        return int((v * 0x0101010101010101ull) >> 56);
+#endif // _HAS_CXX20
+    }
+
+    /**
+    * @param [] x - not 0
+    */
+    static int countr_zero(uint64_t const x) noexcept {
+#if _HAS_CXX20
+        return std::countr_zero(x);
+#else
+        return popcount((x & (0 - x)) - 1);
+#endif // _HAS_CXX20
+    }
+
+    /**
+    * the count of bits needed to represent x, 0 for 0
+    */
+    static int bit_width(uint64_t x) noexcept {
+#if _HAS_CXX20
+        return int(std::bit_width(x));
+#else
+        x |= x >> 1;
+        x |= x >> 2;
+        x |= x >> 4;
+        x |= x >> 8;
+        x |= x >> 16;
+        x |= x >> 32;
+        return popcount(x);
+#endif // _HAS_CXX20
+    }
+
+    /**
+    * sets bit i % 64 of masks[i / 64] to filter(first[i])
+    * @param [out] masks - (last - first + 63) / 64 words
+    * @return the count of set bits
+    */
+    template<class T, class Filter>
+    static type_if<size_t, convertible_v<util::invoke_result_t<Filter&, T const&>, bool>> select_mask(T const* const first, T const* const last, uint64_t* const masks, Filter&& filter) {
+        size_t const n = last - first;
+        size_t res = 0;
+        for (size_t from = 0, word = 0; from < n; from += 64, ++word) {
+            T const* const base = first + from;
+            size_t const k = n - from < 64 ? n - from : 64;
+            uint64_t m = 0;
+            for (size_t j = 0; j != k; ++j) m |= uint64_t(static_cast<bool>(util::invoke(filter, base[j]))) << j;
+            masks[word] = m;
+            res += popcount(m);
+        }
+        return res;
+    }
+
+    /**
+    * copies the elements selected by masks (see select_mask) to dst
+    * @param [] dst - room for exactly the count of the selected elements
+    */
+    template<class T>
+    static type_if<void, std::is_trivially_copyable<T>::value> compress(T const* const first, T const* const last, uint64_t const* const masks, remove_cv_t<T>* const dst, size_t const count) {
+        _compress(first, size_t(last - first), masks, dst, dst + count, conditional<sizeof(T) == 4>{});
+    }
+
+    template<class T> constexpr _INLINE_VAR static bool summable_v = std::is_arithmetic<remove_cv_t<T>>::value && !is_same_v<T, bool>;
+
+    /**
+    * integers are summed in 64 bits
+    */
+    template<class T> using sum_t = conditional<std::is_floating_point<remove_cv_t<T>>::value, remove_cv_t<T>,
+        conditional<std::is_signed<remove_cv_t<T>>::value, long long, unsigned long long>>;
+
+    /**
+    * left fold of the range
+    */
+    template<class T, class Init, class Op>
+    constexpr static type_if<Init, convertible_v<util::invoke_result_t<Op&, Init&&, T const&>, Init>> reduce(T const* first, T const* const last, Init init, Op&& op) {
+        for (; first != last; ++first) init = util::invoke(op, static_cast<Init&&>(init), *first);
+        return init;
+    }
+
+    /**
+    * op is required to be associative: blocks are folded concurrently and then combined in order
+    */
+    template<class Policy, class T, class Init, class Op>
+    static type_if<Init, execution::is_policy_v<Policy>, is_constructible_v<Init, T const&>, convertible_v<util::invoke_result_t<Op&, Init&&, T const&>, Init>,
+        convertible_v<util::invoke_result_t<Op&, Init&&, Init&&>, Init>>
+        reduce(Policy&& policy, T const* const first, T const* const last, Init init, Op&& op) {
+        if (first == last) return init;
+        Init res = _reduce_blocks<Init>(static_cast<Policy&&>(policy), size_t(last - first), [first, &op](size_t const from, size_t const to) {
+            return reduce(first + from + 1, first + to, Init(first[from]), op);
+        }, [&op](Init&& l, Init&& r) -> Init { return util::invoke(op, static_cast<Init&&>(l), static_cast<Init&&>(r)); });
+        return util::invoke(op, static_cast<Init&&>(init), static_cast<Init&&>(res));
+    }
+
+    /**
+    * sums execution::grain-element blocks with _lanes accumulators each and adds the block sums in order;
+    * the sequential and the parallel sums of the same range are equal bit for bit
+    */
+    template<class T> constexpr static type_if<sum_t<T>, summable_v<T>> sum(T const* const first, T const* const last) {
+        size_t const n = last - first;
+        sum_t<T> res{};
+        for (size_t from = 0; from < n; from += execution::grain) res += _sum_block(first + from, n - from < execution::grain ? n - from : execution::grain);
+        return res;
+    }
+
+    template<class Policy, class T> static type_if<sum_t<T>, execution::is_policy_v<Policy>, summable_v<T>> sum(Policy&& policy, T const* const first, T const* const last) {
+        if (first == last) return {};
+        return _reduce_blocks<sum_t<T>>(static_cast<Policy&&>(policy), size_t(last - first), [first](size_t const from, size_t const to) {
+            return _sum_block(first + from, to - from);
+        }, [](sum_t<T> const l, sum_t<T> const r) { return l + r; });
+    }
+
+    /**
+    * @param [] first, last - not empty
+    * @return the first least element
+    */
+    template<class T, class Comp = comporator<void, less>>
+    constexpr static type_if<remove_cv_t<T>, objects::is_ordering_v<util::invoke_result_t<Comp&, T const&, T const&>>> min(T const* const first, T const* const last, Comp&& comp = Comp{}) {
+        return _min(first, size_t(last - first), comp, _lanes_fit<T, Comp>{});
+    }
+
+    /**
+    * @param [] first, last - not empty
+    * @return the first greatest element
+    */
+    template<class T, class Comp = comporator<void, less>>
+    constexpr static type_if<remove_cv_t<T>, objects::is_ordering_v<util::invoke_result_t<Comp&, T const&, T const&>>> max(T const* const first, T const* const last, Comp&& comp = Comp{}) {
+        return _max(first, size_t(last - first), comp, _lanes_fit<T, Comp>{});
+    }
+
+    template<class T, class Comp = comporator<void, less>>
+    constexpr static type_if<pair<remove_cv_t<T>, remove_cv_t<T>>, objects::is_ordering_v<util::invoke_result_t<Comp&, T const&, T const&>>> minmax(T const* const first, T const* const last, Comp&& comp = Comp{}) {
+        return { min(first, last, comp), max(first, last, comp) };
+    }
+
+    template<class Policy, class T, class Comp = comporator<void, less>>
+    static type_if<remove_cv_t<T>, execution::is_policy_v<Policy>, objects::is_ordering_v<util::invoke_result_t<Comp&, T const&, T const&>>>
+        min(Policy&& policy, T const* const first, T const* const last, Comp&& comp = Comp{}) {
+        auto&& less = _less(comp);
+        return _reduce_blocks<remove_cv_t<T>>(static_cast<Policy&&>(policy), size_t(last - first), [first, &comp](size_t const from, size_t const to) {
+            return _min(first + from, to - from, comp, _lanes_fit<T, Comp>{});
+        }, [&less](remove_cv_t<T>&& l, remove_cv_t<T>&& r) { return less(r, l) ? static_cast<remove_cv_t<T>&&>(r) : static_cast<remove_cv_t<T>&&>(l); });
+    }
+
+    template<class Policy, class T, class Comp = comporator<void, less>>
+    static type_if<remove_cv_t<T>, execution::is_policy_v<Policy>, objects::is_ordering_v<util::invoke_result_t<Comp&, T const&, T const&>>>
+        max(Policy&& policy, T const* const first, T const* const last, Comp&& comp = Comp{}) {
+        auto&& less = _less(comp);
+        return _reduce_blocks<remove_cv_t<T>>(static_cast<Policy&&>(policy), size_t(last - first), [first, &comp](size_t const from, size_t const to) {
+            return _max(first + from, to - from, comp, _lanes_fit<T, Comp>{});
+        }, [&less](remove_cv_t<T>&& l, remove_cv_t<T>&& r) { return less(l, r) ? static_cast<remove_cv_t<T>&&>(r) : static_cast<remove_cv_t<T>&&>(l); });
+    }
+
+    template<class Policy, class T, class Comp = comporator<void, less>>
+    static type_if<pair<remove_cv_t<T>, remove_cv_t<T>>, execution::is_policy_v<Policy>, objects::is_ordering_v<util::invoke_result_t<Comp&, T const&, T const&>>>
+        minmax(Policy&& policy, T const* const first, T const* const last, Comp&& comp = Comp{}) {
+        return { min(policy, first, last, comp), max(policy, first, last, comp) };
+    }
+
+    template<class T, class Pred>
+    constexpr static type_if<size_t, convertible_v<util::invoke_result_t<Pred&, T const&>, bool>> count_if(T const* first, T const* const last, Pred&& pred) {
+        size_t res = 0;
+        for (; first != last; ++first) res += static_cast<bool>(util::invoke(pred, *first)) ? 1 : 0;
+        return res;
+    }
+
+    template<class Policy, class T, class Pred>
+    static type_if<size_t, execution::is_policy_v<Policy>, convertible_v<util::invoke_result_t<Pred&, T const&>, bool>> count_if(Policy&& policy, T const* const first, T const* const last, Pred&& pred) {
+        if (first == last) return 0;
+        return _reduce_blocks<size_t>(static_cast<Policy&&>(policy), size_t(last - first), [first, &pred](size_t const from, size_t const to) {
+            return count_if(first + from, first + to, pred);
+        }, [](size_t const l, size_t const r) { return l + r; });
+    }
+
+    /**
+    * pred is evaluated over whole blocks of _any_block elements, so it may see elements past the first match
+    */
+    template<class T, class Pred>
+    constexpr static type_if<bool, convertible_v<util::invoke_result_t<Pred&, T const&>, bool>> any_of(T const* first, T const* const last, Pred&& pred) {
+        for (; last - first >= _any_block; first += _any_block) {
+            bool any = false;
+            for (ptrdiff_t i = 0; i != _any_block; ++i) any |= static_cast<bool>(util::invoke(pred, first[i]));
+            if (any) return true;
+        }
+        for (; first != last; ++first) {
+            if (util::invoke(pred, *first)) return true;
+        }
+        return false;
+    }
+
+    template<class T, class Pred>
+    constexpr static type_if<bool, convertible_v<util::invoke_result_t<Pred&, T const&>, bool>> all_of(T const* const first, T const* const last, Pred&& pred) {
+        return !any_of(first, last, _not<remove_ref_t<Pred>>{ pred });
+    }
+
+    template<class T> constexpr _INLINE_VAR static bool radix_sortable_v = !is_const_v<T> && (std::is_integral<remove_cv_t<T>>::value ||
+        is_same_v<T, float> || is_same_v<T, double>);
+
+    /**
+    * LSD radix sort by 8-bit digits, stable
+    */
+    template<class T> static type_if<void, radix_sortable_v<T>> radix_sort(T* const first, T* const last) {
+        size_t const n = last - first;
+        if (n < 2) return;
+
+        constexpr size_t passes = sizeof(T);
+        size_t counts[passes][256]{};
+        for (T* i = first; i != last; ++i) {
+            auto const key = _radix_key(*i);
+            for (size_t pass = 0; pass != passes; ++pass) ++counts[pass][(key >> (pass * 8)) & 0xff];
+        }
+
+        std::unique_ptr<remove_cv_t<T>[]> const buffer(new remove_cv_t<T>[n]);
+        T* src = first;
+        T* dst = buffer.get();
+        for (size_t pass = 0; pass != passes; ++pass) {
+            size_t* const count = counts[pass];
+            if (count[(_radix_key(*src) >> (pass * 8)) & 0xff] == n) continue;
+
+            size_t offset = 0;
+            for (size_t digit = 0; digit != 256; ++digit) {
+                size_t const c = count[digit];
+                count[digit] = offset;
+                offset += c;
+            }
+            for (T* i = src, *const end = src + n; i != end; ++i) {
+                T const value = *i;
+                dst[count[(_radix_key(value) >> (pass * 8)) & 0xff]++] = value;
+            }
+            T* const tmp = src;
+            src = dst;
+            dst = tmp;
+        }
+        if (src != first) std::memcpy(first, src, n * sizeof(T));
+    }
+
+    /**
+    * introsort; radix sort for large ranges of arithmetic values in natural order
+    * @param [] comp - three-way ordering functor
+    */
+    template<class T, class Comp = comporator<void, less>>
+    constexpr static type_if<void, is_move_assignable_v<T>, objects::is_ordering_v<util::invoke_result_t<Comp&, T const&, T const&>>>
+        sort(T* const first, T* const last, Comp&& comp = Comp{}) {
+        if (_radix_sort(first, last, conditional<radix_sortable_v<T> && _natural_order_v<Comp>>{})) return;
+        auto&& less = _less(comp);
+        _sort(first, last, less);
+    }
+
+    /**
+    * merge sort, insertion sort for short ranges; radix sort for large ranges of integral values in natural order.
+    * Not for floating point: radix orders -0.0 before 0.0, which compare equal, and places NaNs apart
+    * @param [] comp - three-way ordering functor
+    */
+    template<class T, class Comp = comporator<void, less>>
+    constexpr static type_if<void, is_move_assignable_v<T>, objects::is_ordering_v<util::invoke_result_t<Comp&, T const&, T const&>>>
+        stable_sort(T* const first, T* const last, Comp&& comp = Comp{}) {
+        auto&& less = _less(comp);
+        if (last - first <= _merge_threshold) {
+            _insertion_sort(first, last, less);
+            return;
+        }
+        if (_radix_sort(first, last, conditional<radix_sortable_v<T> && std::is_integral<remove_cv_t<T>>::value && _natural_order_v<Comp>>{})) return;
+        _stable_sort(first, last, less);
+    }
+
+    template<class Policy, class T, class Comp = comporator<void, less>>
+    static type_if<void, execution::is_policy_v<Policy>, is_move_assignable_v<T>, objects::is_ordering_v<util::invoke_result_t<Comp&, T const&, T const&>>>
+        sort(Policy&& policy, T* const first, T* const last, Comp&& comp = Comp{}) {
+        if (!execution::is_parallel_v<Policy>) {
+            sort(first, last, comp);
+            return;
+        }
+        auto&& less = _less(comp);
+        _parallel_sort(static_cast<Policy&&>(policy), first, last, less, [&comp](T* const from, T* const to) { sort(from, to, comp); });
+    }
+
+    template<class Policy, class T, class Comp = comporator<void, less>>
+    static type_if<void, execution::is_policy_v<Policy>, is_move_assignable_v<T>, objects::is_ordering_v<util::invoke_result_t<Comp&, T const&, T const&>>>
+        stable_sort(Policy&& policy, T* const first, T* const last, Comp&& comp = Comp{}) {
+        if (!execution::is_parallel_v<Policy>) {
+            stable_sort(first, last, comp);
+            return;
+        }
+        auto&& less = _less(comp);
+        _parallel_sort(static_cast<Policy&&>(policy), first, last, less, [&comp](T* const from, T* const to) { stable_sort(from, to, comp); });
+    }
+
+    /**
+    * @param [] first, last - a range sorted by comp
+    * @param [] comp - three-way ordering functor
+    * @return the index of the first element not less than value
+    */
+    template<class T, class U, class Comp = comporator<void, less>>
+    constexpr static type_if<size_t, objects::is_ordering_v<util::invoke_result_t<Comp&, T const&, U const&>>>
+        lower_bound(T const* const first, T const* const last, U const& value, Comp&& comp = Comp{}) {
+        auto&& less = _less(comp);
+        return _partition_point(first, size_t(last - first), _before<U, remove_ref_t<decltype(less)>>{ value, less });
+    }
+
+    /**
+    * @return the index of the first element greater than value
+    */
+    template<class T, class U, class Comp = comporator<void, less>>
+    constexpr static type_if<size_t, objects::is_ordering_v<util::invoke_result_t<Comp&, U const&, T const&>>>
+        upper_bound(T const* const first, T const* const last, U const& value, Comp&& comp = Comp{}) {
+        auto&& less = _less(comp);
+        return _partition_point(first, size_t(last - first), _not_after<U, remove_ref_t<decltype(less)>>{ value, less });
+    }
+
+    template<class T, class U, class Comp = comporator<void, less>>
+    constexpr static type_if<pair<size_t, size_t>, objects::is_ordering_v<util::invoke_result_t<Comp&, T const&, U const&>>, objects::is_ordering_v<util::invoke_result_t<Comp&, U const&, T const&>>>
+        equal_range(T const* const first, T const* const last, U const& value, Comp&& comp = Comp{}) {
+        size_t const lo = lower_bound(first, last, value, comp);
+        return { lo, lo + upper_bound(first + lo, last, value, comp) };
+    }
+
+    template<class T, class U, class Comp = comporator<void, less>>
+    constexpr static type_if<bool, objects::is_ordering_v<util::invoke_result_t<Comp&, T const&, U const&>>, objects::is_ordering_v<util::invoke_result_t<Comp&, U const&, T const&>>>
+        contains(T const* const first, T const* const last, U const& value, Comp&& comp = Comp{}) {
+        size_t const i = lower_bound(first, last, value, comp);
+        auto&& less = _less(comp);
+        return first + i != last && !less(value, first[i]);
+    }
+
+    /**
+    * lower_bound of every values[i] into out[i]; runs the searches in interleaved groups, so the cache misses of one search
+    * overlap with the others, and prefetches both candidate midpoints of each next step as _partition_point does
+    */
+    template<class T, class U, class Comp = comporator<void, less>>
+    static type_if<void, objects::is_ordering_v<util::invoke_result_t<Comp&, T const&, U const&>>>
+        lower_bound_many(T const* const first, T const* const last, U const* const values, size_t const count, size_t* const out, Comp&& comp = Comp{}) {
+        auto&& less = _less(comp);
+        size_t const n = last - first;
+        for (size_t done = 0; done < count; done += _interleave) {
+            size_t const k = count - done < _interleave ? count - done : _interleave;
+            U const* const group = values + done;
+            if (n == 0) {
+                for (size_t j = 0; j != k; ++j) out[done + j] = 0;
+                continue;
+            }
+            T const* base[_interleave];
+            for (size_t j = 0; j != k; ++j) base[j] = first;
+            for (size_t len = n; len > 1; ) {
+                size_t const half = len / 2;
+                if (len > _prefetch_threshold) {
+                    size_t const next = (len - half) / 2;
+                    for (size_t j = 0; j != k; ++j) {
+                        _prefetch(base[j] + next);
+                        _prefetch(base[j] + half + next);
+                    }
+                }
+                for (size_t j = 0; j != k; ++j) base[j] = less(base[j][half], group[j]) ? base[j] + half : base[j];
+                len -= half;
+            }
+            for (size_t j = 0; j != k; ++j) out[done + j] = size_t(base[j] - first) + less(*base[j], group[j]);
+        }
+    }
+
+    /**
+    * the side of a square tile of T filling a 4 KiB page
+    */
+    template<class T> constexpr _INLINE_VAR static size_t tile_v = sizeof(T) == 1 ? 64 : sizeof(T) <= 4 ? 32 : sizeof(T) <= 16 ? 16 : 8;
+
+    /**
+    * dst(j, i) = src(i, j), copied tile by tile so that both the rows read and the columns written stay cached
+    * @param [] src, src_stride - rows x cols elements, rows src_stride apart
+    * @param [] dst, dst_stride - cols x rows elements, rows dst_stride apart
+    */
+    template<class T, class U>
+    constexpr static type_if<void, is_assignable_v<U&, T const&>>
+        transpose(T const* const src, size_t const rows, size_t const cols, ptrdiff_t const src_stride, U* const dst, ptrdiff_t const dst_stride) {
+        for (size_t i = 0; i < rows; i += tile_v<T>) _transpose_band(src, i, rows, cols, src_stride, dst, dst_stride);
+    }
+
+    template<class Policy, class T, class U>
+    static type_if<void, execution::is_policy_v<Policy>, is_assignable_v<U&, T const&>>
+        transpose(Policy&& policy, T const* const src, size_t const rows, size_t const cols, ptrdiff_t const src_stride, U* const dst, ptrdiff_t const dst_stride) {
+        if (!execution::is_parallel_v<Policy> || rows * cols < execution::grain) {
+            transpose(src, rows, cols, src_stride, dst, dst_stride);
+            return;
+        }
+        execution::for_n(static_cast<Policy&&>(policy), (rows + tile_v<T> - 1) / tile_v<T>, [=](size_t const band) {
+            _transpose_band(src, band * tile_v<T>, rows, cols, src_stride, dst, dst_stride);
+        });
+    }
+
+    /**
+    * transposes a square n x n matrix in place, swapping mirrored tiles
+    * @param [] stride - the distance between rows
+    */
+    template<class T>
+    constexpr static type_if<void, is_move_assignable_v<T>> transpose(T* const data, size_t const n, ptrdiff_t const stride) {
+        constexpr size_t tile = tile_v<T>;
+        for (size_t i0 = 0; i0 < n; i0 += tile) {
+            size_t const i1 = n - i0 < tile ? n : i0 + tile;
+            for (size_t i = i0; i != i1; ++i) {
+                for (size_t j = i + 1; j != i1; ++j) _swap(data[ptrdiff_t(i) * stride + ptrdiff_t(j)], data[ptrdiff_t(j) * stride + ptrdiff_t(i)]);
+            }
+            for (size_t j0 = i1; j0 < n; j0 += tile) {
+                size_t const j1 = n - j0 < tile ? n : j0 + tile;
+                for (size_t i = i0; i != i1; ++i) {
+                    for (size_t j = j0; j != j1; ++j) _swap(data[ptrdiff_t(i) * stride + ptrdiff_t(j)], data[ptrdiff_t(j) * stride + ptrdiff_t(i)]);
+                }
+            }
+        }
+    }
+
+    /**
+    * c = a * b, panel by panel of b so that it stays cached, _gemm_rows rows of c at once
+    * @param [] a, lda - n x k elements, rows lda apart
+    * @param [] b, ldb - k x m elements, rows ldb apart
+    * @param [] c, ldc - n x m elements, rows ldc apart, must not overlap a or b
+    */
+    template<class T>
+    static type_if<void, summable_v<T>> gemm(T const* const a, T const* const b, T* const c, size_t const n, size_t const k, size_t const m,
+        ptrdiff_t const lda, ptrdiff_t const ldb, ptrdiff_t const ldc) {
+        _gemm_rows_range(a, b, c, 0, n, k, m, lda, ldb, ldc);
+    }
+
+    template<class Policy, class T>
+    static type_if<void, execution::is_policy_v<Policy>, summable_v<T>> gemm(Policy&& policy, T const* const a, T const* const b, T* const c,
+        size_t const n, size_t const k, size_t const m, ptrdiff_t const lda, ptrdiff_t const ldb, ptrdiff_t const ldc) {
+        if (!execution::is_parallel_v<Policy> || n * k * m < execution::grain * _gemm_rows * 64) {
+            _gemm_rows_range(a, b, c, 0, n, k, m, lda, ldb, ldc);
+            return;
+        }
+        size_t const bands = (n + _gemm_rows - 1) / _gemm_rows;
+        execution::for_chunks(static_cast<Policy&&>(policy), bands, _gemm_rows * k * m, [=](size_t const first, size_t const last) {
+            size_t const to = last * _gemm_rows < n ? last * _gemm_rows : n;
+            _gemm_rows_range(a, b, c, first * _gemm_rows, to, k, m, lda, ldb, ldc);
+        });
+    }
+
+    /**
+    * c = a * b over dense rows with the extents known at compile time: up to _gemm_small multiply-adds the loops have constant
+    * bounds, so they unroll and vectorize with a row of c in registers; larger products take the blocked gemm
+    */
+    template<size_t N, size_t K, size_t M, class T>
+    static type_if<void, summable_v<T>, (N * K * M <= _gemm_small)> gemm(T const* const a, T const* const b, T* const c) {
+        for (size_t i = 0; i != N; ++i) {
+            T row[M] = {};
+            for (size_t p = 0; p != K; ++p) {
+                T const ap = a[i * K + p];
+                for (size_t j = 0; j != M; ++j) row[j] += ap * b[p * M + j];
+            }
+            for (size_t j = 0; j != M; ++j) c[i * M + j] = row[j];
+        }
+    }
+
+    template<size_t N, size_t K, size_t M, class T>
+    static type_if<void, summable_v<T>, (N * K * M > _gemm_small)> gemm(T const* const a, T const* const b, T* const c) {
+        _gemm_rows_range(a, b, c, 0, N, K, M, ptrdiff_t(K), ptrdiff_t(M), ptrdiff_t(M));
+    }
+
+    template<size_t N, size_t K, size_t M, class Policy, class T>
+    static type_if<void, execution::is_policy_v<Policy>, summable_v<T>> gemm(Policy&& policy, T const* const a, T const* const b, T* const c) {
+        if (N * K * M <= _gemm_small) gemm<N, K, M>(a, b, c);
+        else gemm(static_cast<Policy&&>(policy), a, b, c, N, K, M, ptrdiff_t(K), ptrdiff_t(M), ptrdiff_t(M));
+    }
+
+    /**
+    * y = a * x
+    * @param [] a, lda - n x m elements, rows lda apart
+    */
+    template<class T>
+    static type_if<void, summable_v<T>> gemv(T const* const a, T const* const x, T* const y, size_t const n, size_t const m, ptrdiff_t const lda) {
+        for (size_t i = 0; i != n; ++i) y[i] = _dot(a + ptrdiff_t(i) * lda, x, m);
+    }
+
+    template<class Policy, class T>
+    static type_if<void, execution::is_policy_v<Policy>, summable_v<T>> gemv(Policy&& policy, T const* const a, T const* const x, T* const y,
+        size_t const n, size_t const m, ptrdiff_t const lda) {
+        if (!execution::is_parallel_v<Policy> || n * m < execution::grain) {
+            gemv(a, x, y, n, m, lda);
+            return;
+        }
+        execution::for_chunks(static_cast<Policy&&>(policy), n, m, [=](size_t const first, size_t const last) {
+            for (size_t i = first; i != last; ++i) y[i] = _dot(a + ptrdiff_t(i) * lda, x, m);
+        });
+    }
+
+    /**
+    * y = a * x over dense rows with the extents known at compile time; small products unroll as the fixed gemm does
+    */
+    template<size_t N, size_t M, class T>
+    static type_if<void, summable_v<T>> gemv(T const* const a, T const* const x, T* const y) {
+        if (N * M > _gemm_small) {
+            gemv(a, x, y, N, M, ptrdiff_t(M));
+            return;
+        }
+        for (size_t i = 0; i != N; ++i) {
+            T acc = T();
+            for (size_t j = 0; j != M; ++j) acc += a[i * M + j] * x[j];
+            y[i] = acc;
+        }
+    }
+
+    template<size_t N, size_t M, class Policy, class T>
+    static type_if<void, execution::is_policy_v<Policy>, summable_v<T>> gemv(Policy&& policy, T const* const a, T const* const x, T* const y) {
+        if (N * M <= _gemm_small) gemv<N, M>(a, x, y);
+        else gemv(static_cast<Policy&&>(policy), a, x, y, N, M, ptrdiff_t(M));
+    }
+
+protected:
+    /**
+    * the depth and width of a panel of b kept cached by gemm, and the count of rows of c sharing each load from b
+    */
+    constexpr _INLINE_VAR static size_t _gemm_depth = 256;
+    constexpr _INLINE_VAR static size_t _gemm_width = 512;
+    constexpr _INLINE_VAR static size_t _gemm_rows = 4;
+
+    template<class T>
+    static void _gemm_rows_range(T const* const a, T const* const b, T* const c, size_t const from, size_t const to, size_t const k, size_t const m,
+        ptrdiff_t const lda, ptrdiff_t const ldb, ptrdiff_t const ldc) {
+        for (size_t i = from; i != to; ++i) {
+            T* const ci = c + ptrdiff_t(i) * ldc;
+            for (size_t j = 0; j != m; ++j) ci[j] = T();
+        }
+        for (size_t p0 = 0; p0 < k; p0 += _gemm_depth) {
+            size_t const p1 = k - p0 < _gemm_depth ? k : p0 + _gemm_depth;
+            for (size_t j0 = 0; j0 < m; j0 += _gemm_width) {
+                size_t const j1 = m - j0 < _gemm_width ? m : j0 + _gemm_width;
+                size_t i = from;
+                for (; to - i >= _gemm_rows; i += _gemm_rows) {
+                    T* const c0 = c + ptrdiff_t(i) * ldc;
+                    T* const c1 = c0 + ldc;
+                    T* const c2 = c1 + ldc;
+                    T* const c3 = c2 + ldc;
+                    T const* const ai = a + ptrdiff_t(i) * lda;
+                    for (size_t p = p0; p != p1; ++p) {
+                        T const a0 = ai[p];
+                        T const a1 = ai[lda + ptrdiff_t(p)];
+                        T const a2 = ai[2 * lda + ptrdiff_t(p)];
+                        T const a3 = ai[3 * lda + ptrdiff_t(p)];
+                        T const* const bp = b + ptrdiff_t(p) * ldb;
+                        for (size_t j = j0; j != j1; ++j) {
+                            T const bj = bp[j];
+                            c0[j] += a0 * bj;
+                            c1[j] += a1 * bj;
+                            c2[j] += a2 * bj;
+                            c3[j] += a3 * bj;
+                        }
+                    }
+                }
+                for (; i != to; ++i) {
+                    T* const ci = c + ptrdiff_t(i) * ldc;
+                    T const* const ai = a + ptrdiff_t(i) * lda;
+                    for (size_t p = p0; p != p1; ++p) {
+                        T const ap = ai[p];
+                        T const* const bp = b + ptrdiff_t(p) * ldb;
+                        for (size_t j = j0; j != j1; ++j) ci[j] += ap * bp[j];
+                    }
+                }
+            }
+        }
+    }
+
+    /**
+    * _lanes independent partial sums, so the loop vectorizes without reassociating
+    */
+    template<class T> static T _dot(T const* const a, T const* const x, size_t const n) {
+        T acc[_lanes] = {};
+        size_t i = 0;
+        for (; n - i >= _lanes; i += _lanes) {
+            for (size_t l = 0; l != _lanes; ++l) acc[l] += a[i + l] * x[i + l];
+        }
+        for (; i != n; ++i) acc[0] += a[i] * x[i];
+        T res = T();
+        for (size_t l = 0; l != _lanes; ++l) res += acc[l];
+        return res;
+    }
+
+    /**
+    * transposes the rows [from, from + tile) of src
+    */
+    template<class T, class U>
+    constexpr static void _transpose_band(T const* const src, size_t const from, size_t const rows, size_t const cols, ptrdiff_t const src_stride, U* const dst, ptrdiff_t const dst_stride) {
+        constexpr size_t tile = tile_v<T>;
+        size_t const to = rows - from < tile ? rows : from + tile;
+        for (size_t j0 = 0; j0 < cols; j0 += tile) {
+            size_t const j1 = cols - j0 < tile ? cols : j0 + tile;
+            for (size_t i = from; i != to; ++i) {
+                T const* const row = src + ptrdiff_t(i) * src_stride;
+                for (size_t j = j0; j != j1; ++j) dst[ptrdiff_t(j) * dst_stride + ptrdiff_t(i)] = row[j];
+            }
+        }
+    }
+};
+
+#endif // !__ALGORITHM_HPP
@@ -44,6 +44,9 @@ namespace std
 #include "iterator.hpp"
 #include "container.hpp"
 #include "object.hpp"
+#include "execution.hpp"
+#include "algorithm.hpp"
+#include "mdspan.hpp"
 
 using arrays = array<void>;
 
@@ -135,6 +138,12 @@ public:
 
     template<class C> constexpr _INLINE_VAR static bool has_constexpr_size_v = has_constexpr_size<C>::value;
 
+    struct for_overwrite_t {
+        explicit for_overwrite_t() = default;
+    };
+
+    constexpr _INLINE_VAR static for_overwrite_t for_overwrite{};
+
 protected:
     struct _dummy {};
     struct _map {};
@@ -147,6 +156,18 @@ protected:
         return c.size();
     }
 
+    template<class Policy, class C, class Proc, class... Args> static auto _foreach(Policy&& policy, C& c, Proc&& proc, Args&&... args)
+        -> type_if<decltype(c.size()), execution::is_policy_v<Policy>, util::invocable_v<Proc&, decltype(*c._Unchecked_begin()), Args&...>> {
+        auto const data = c._Unchecked_begin();
+        // shared by every chunk at once, so passed as lvalues: never moved from
+        execution::for_chunks(static_cast<Policy&&>(policy), c.size(), [data, &proc, &args...](size_t const first, size_t const last) {
+            for (auto i = data + first, end = data + last; i != end; ++i) {
+                util::invoke(proc, *i, args...);
+            }
+        });
+        return c.size();
+    }
+
     template<class C, class Proc, class... Args> constexpr static auto _rforeach(C& c, Proc&& proc, Args&&... args) noexcept(util::nothrow_invocable_v<Proc, decltype(*c._Unchecked_begin()), Args...>)
         -> type_if<decltype(c.size()), util::invocable_v<Proc, decltype(*c._Unchecked_begin()), Args...>> {
         for (auto i = c._Unchecked_end(), rend = c._Unchecked_begin(); i != rend; ) {
@@ -178,11 +199,32 @@ public:
         return from(static_cast<Tuple&&>(tuple), Indices{});
     }
 
-    template<class Array, class Mapper, class... Args, class T = util::invoke_result_t<Mapper, container::const_reference<Array>, Args...>>
+    template<class Array, class Mapper, class... Args, type_if<int, !execution::is_policy_v<Array>, has_constexpr_size_v<Array>> = 0,
+        class T = util::invoke_result_t<Mapper, container::const_reference<Array>, Args...>>
     _NODISCARD static array<T, size<Array>> map(Array const& arr, Mapper&& mapper, Args&&... args) {
         return { _map{}, container::data(arr), mapper, static_cast<Args&&>(args)... };
     }
 
+    template<class Array, class Mapper, class... Args, type_if<int, !execution::is_policy_v<Array>, !has_constexpr_size_v<Array>, container::data_availability_v<Array>, container::sizeable_v<Array>> = 0,
+        class T = util::invoke_result_t<Mapper, container::const_reference<Array>, Args...>>
+    _NODISCARD static array<T> map(Array const& arr, Mapper&& mapper, Args&&... args) {
+        return _map_n<T>(execution::seq, container::size(arr), container::data(arr), mapper, static_cast<Args&&>(args)...);
+    }
+
+    template<class Policy, class Array, class Mapper, class... Args, type_if<int, execution::is_policy_v<Policy>, has_constexpr_size_v<Array>> = 0,
+        class T = util::invoke_result_t<Mapper&, container::const_reference<Array>, Args...>>
+    _NODISCARD static array<T, size<Array>> map(Policy&& policy, Array const& arr, Mapper&& mapper, Args&&... args) {
+        array<T, size<Array>> res = _dummy{};
+        _map_chunks(static_cast<Policy&&>(policy), size<Array>, res.m_elems, container::data(arr), mapper, args...);
+        return res;
+    }
+
+    template<class Policy, class Array, class Mapper, class... Args, type_if<int, execution::is_policy_v<Policy>, !has_constexpr_size_v<Array>, container::data_availability_v<Array>, container::sizeable_v<Array>> = 0,
+        class T = util::invoke_result_t<Mapper&, container::const_reference<Array>, Args...>>
+    _NODISCARD static array<T> map(Policy&& policy, Array const& arr, Mapper&& mapper, Args&&... args) {
+        return _map_n<T>(static_cast<Policy&&>(policy), container::size(arr), container::data(arr), mapper, args...);
+    }
+
     template<class I> _NODISCARD static auto from(I begin, I end)
         -> type_if<array<remove_const_t<remove_ref_t<decltype(*begin)>>>, iterators::fwd_iter_v<I>> {
         return { begin, end };
@@ -196,6 +238,100 @@ public:
         return { std::nothrow, size, data };
     }
 
+    /**
+    * materializes a view (anything with foreach and value_type): sized views are constructed in place,
+    * the others into a buffer grown twofold
+    */
+    template<class View, class T = remove_const_t<typename View::value_type>> _NODISCARD static array<T> collect(View const& view) {
+        return _collect<T>(view, 0);
+    }
+
+    /**
+    * the extents are known at compile time, so small products take the unrolled kernels of algorithms::gemm<N, K, M>
+    */
+    template<class T, size_t N, size_t K, size_t M>
+    _NODISCARD static type_if<array<T, N, M>, algorithms::summable_v<T>> matmul(array<T, N, K> const& a, array<T, K, M> const& b) {
+        array<T, N, M> res;
+        algorithms::gemm<N, K, M>(a.span().data(), b.span().data(), res.span().data());
+        return res;
+    }
+
+    template<class Policy, class T, size_t N, size_t K, size_t M>
+    _NODISCARD static type_if<array<T, N, M>, execution::is_policy_v<Policy>, algorithms::summable_v<T>> matmul(Policy&& policy, array<T, N, K> const& a, array<T, K, M> const& b) {
+        array<T, N, M> res;
+        algorithms::gemm<N, K, M>(static_cast<Policy&&>(policy), a.span().data(), b.span().data(), res.span().data());
+        return res;
+    }
+
+    template<class T, size_t N, size_t M>
+    _NODISCARD static type_if<array<T, N>, algorithms::summable_v<T>> matvec(array<T, N, M> const& a, array<T, M> const& x) {
+        array<T, N> res = _dummy{};
+        algorithms::gemv<N, M>(a.span().data(), x.m_elems, res.m_elems);
+        return res;
+    }
+
+    template<class Policy, class T, size_t N, size_t M>
+    _NODISCARD static type_if<array<T, N>, execution::is_policy_v<Policy>, algorithms::summable_v<T>> matvec(Policy&& policy, array<T, N, M> const& a, array<T, M> const& x) {
+        array<T, N> res = _dummy{};
+        algorithms::gemv<N, M>(static_cast<Policy&&>(policy), a.span().data(), x.m_elems, res.m_elems);
+        return res;
+    }
+
+protected:
+    template<class Policy, class D, class S, class Mapper, class... Args> static void _map_chunks(Policy&& policy, size_t const size, D* dst, S src, Mapper& mapper, Args&... args) {
+        execution::for_chunks(static_cast<Policy&&>(policy), size, [dst, src, &mapper, &args...](size_t const first, size_t const last) {
+            _map_construct(dst + first, dst + last, src + first, mapper, args...);
+        });
+    }
+
+    template<class T, class Policy, class S, class Mapper, class... Args> static array<T> _map_n(Policy&& policy, size_t const size, S src, Mapper& mapper, Args&&... args) {
+        auto* const data = array<T>::_alloc(for_overwrite, size);
+        _map_chunks(static_cast<Policy&&>(policy), size, data, src, mapper, args...);
+        return { data, size };
+    }
+
+    template<class T, class View> static type_if<array<T>, sfinae_v<decltype(std::declval<View const&>().size())>> _collect(View const& view, int) {
+        size_t const size = view.size();
+        auto* const data = array<T>::_alloc(for_overwrite, size);
+        size_t i = 0;
+        view.foreach([data, &i](auto&& value) {
+            new(data + i++) T(static_cast<decltype(value)&&>(value));
+        });
+        return { data, size };
+    }
+
+    template<class T, class View> static array<T> _collect(View const& view, long) {
+        size_t size = 0;
+        size_t capacity = 0;
+        T* data = nullptr;
+        view.foreach([&size, &capacity, &data](auto&& value) {
+            if (size == capacity) {
+                capacity = capacity ? capacity * 2 : 16;
+                auto* const grown = array<T>::_alloc(for_overwrite, capacity);
+                for (size_t i = 0; i != size; ++i) {
+                    new(grown + i) T(static_cast<T&&>(data[i]));
+                }
+                objects::destroy_range(data, data + size);
+                if (data) array<T>::_free(data);
+                data = grown;
+            }
+            new(data + size++) T(static_cast<decltype(value)&&>(value));
+        });
+        return { data, size };
+    }
+
+    template<class C, class U, class Comp> static array<size_t> _lower_bound_many(C const& c, array<U> const& values, Comp& comp) {
+        auto* const data = array<size_t>::_alloc(for_overwrite, values.size());
+        algorithms::lower_bound_many(c._Unchecked_begin(), c._Unchecked_end(), values._Unchecked_begin(), values.size(), data, comp);
+        return { data, values.size() };
+    }
+
+    template<class C, class U, size_t K, class Comp> static array<size_t, K> _lower_bound_many(C const& c, array<U, K> const& values, Comp& comp) {
+        array<size_t, K> res = _dummy{};
+        algorithms::lower_bound_many(c._Unchecked_begin(), c._Unchecked_end(), values._Unchecked_begin(), K, res.m_elems, comp);
+        return res;
+    }
+
     template<class, size_t...> friend struct array;
 };
 
@@ -275,6 +411,26 @@ template<class T> struct array<T, 0> {
 
     _NODISCARD constexpr array reversed() noexcept { return {}; }
 
+    template<class Comp = comporator<void, less>> constexpr void sort(Comp&& = Comp{}) noexcept {}
+
+    template<class Comp = comporator<void, less>> constexpr void stable_sort(Comp&& = Comp{}) noexcept {}
+
+    template<class U = T, class Comp = comporator<void, less>> _NODISCARD constexpr size_type lower_bound(U const&, Comp&& = Comp{}) const noexcept { return 0; }
+
+    template<class U = T, class Comp = comporator<void, less>> _NODISCARD constexpr size_type upper_bound(U const&, Comp&& = Comp{}) const noexcept { return 0; }
+
+    template<class U = T, class Comp = comporator<void, less>> _NODISCARD constexpr pair<size_type, size_type> equal_range(U const&, Comp&& = Comp{}) const noexcept { return { 0, 0 }; }
+
+    template<class U = T, class Comp = comporator<void, less>> _NODISCARD constexpr bool contains(U const&, Comp&& = Comp{}) const noexcept { return false; }
+
+    template<class Init, class Op> _NODISCARD constexpr Init reduce(Init init, Op&&) const { return init; }
+
+    template<class Pred> _NODISCARD constexpr size_type count_if(Pred&&) const noexcept { return 0; }
+
+    template<class Pred> _NODISCARD constexpr bool any_of(Pred&&) const noexcept { return false; }
+
+    template<class Pred> _NODISCARD constexpr bool all_of(Pred&&) const noexcept { return true; }
+
     ~array() noexcept { objects::destroy(m_data); }
 
 protected:
@@ -513,6 +669,108 @@ template<class T, size_t N> struct array<T, N> {
         return reversed;
     }
 
+    /**
+    * @param [] comp - three-way ordering functor
+    */
+    template<class Comp = comporator<void, less>>
+    constexpr type_if<void, is_move_assignable_v<T>, objects::is_ordering_v<util::invoke_result_t<Comp&, const_reference, const_reference>>> sort(Comp&& comp = Comp{}) {
+        algorithms::sort(m_elems, m_elems + N, comp);
+    }
+
+    template<class Comp = comporator<void, less>>
+    constexpr type_if<void, is_move_assignable_v<T>, objects::is_ordering_v<util::invoke_result_t<Comp&, const_reference, const_reference>>> stable_sort(Comp&& comp = Comp{}) {
+        algorithms::stable_sort(m_elems, m_elems + N, comp);
+    }
+
+    /**
+    * @param [] value - searched in the array sorted by comp
+    * @param [] comp - three-way ordering functor
+    * @return the index of the first element not less than value
+    */
+    template<class U = T, class Comp = comporator<void, less>>
+    _NODISCARD constexpr type_if<size_type, objects::is_ordering_v<util::invoke_result_t<Comp&, const_reference, U const&>>> lower_bound(U const& value, Comp&& comp = Comp{}) const {
+        return algorithms::lower_bound(_Unchecked_begin(), _Unchecked_end(), value, comp);
+    }
+
+    /**
+    * @return the index of the first element greater than value
+    */
+    template<class U = T, class Comp = comporator<void, less>>
+    _NODISCARD constexpr type_if<size_type, objects::is_ordering_v<util::invoke_result_t<Comp&, U const&, const_reference>>> upper_bound(U const& value, Comp&& comp = Comp{}) const {
+        return algorithms::upper_bound(_Unchecked_begin(), _Unchecked_end(), value, comp);
+    }
+
+    template<class U = T, class Comp = comporator<void, less>>
+    _NODISCARD constexpr type_if<pair<size_type, size_type>, objects::is_ordering_v<util::invoke_result_t<Comp&, const_reference, U const&>>, objects::is_ordering_v<util::invoke_result_t<Comp&, U const&, const_reference>>>
+        equal_range(U const& value, Comp&& comp = Comp{}) const {
+        return algorithms::equal_range(_Unchecked_begin(), _Unchecked_end(), value, comp);
+    }
+
+    template<class U = T, class Comp = comporator<void, less>>
+    _NODISCARD constexpr type_if<bool, objects::is_ordering_v<util::invoke_result_t<Comp&, const_reference, U const&>>, objects::is_ordering_v<util::invoke_result_t<Comp&, U const&, const_reference>>>
+        contains(U const& value, Comp&& comp = Comp{}) const {
+        return algorithms::contains(_Unchecked_begin(), _Unchecked_end(), value, comp);
+    }
+
+    /**
+    * lower_bound of each of values, the searches interleaved to overlap their cache misses
+    */
+    template<class U, class Comp = comporator<void, less>>
+    _NODISCARD type_if<array<size_type>, objects::is_ordering_v<util::invoke_result_t<Comp&, const_reference, U const&>>> lower_bound_many(array<U> const& values, Comp&& comp = Comp{}) const {
+        return arrays::_lower_bound_many(*this, values, comp);
+    }
+
+    template<class U, size_t K, class Comp = comporator<void, less>>
+    _NODISCARD type_if<array<size_type, K>, (K > 0), objects::is_ordering_v<util::invoke_result_t<Comp&, const_reference, U const&>>> lower_bound_many(array<U, K> const& values, Comp&& comp = Comp{}) const {
+        return arrays::_lower_bound_many(*this, values, comp);
+    }
+
+    /**
+    * left fold of the elements
+    */
+    template<class Init, class Op>
+    _NODISCARD constexpr type_if<Init, convertible_v<util::invoke_result_t<Op&, Init&&, const_reference>, Init>> reduce(Init init, Op&& op) const {
+        return algorithms::reduce(_Unchecked_begin(), _Unchecked_end(), static_cast<Init&&>(init), op);
+    }
+
+    /**
+    * deterministic multi-accumulator sum, integers are summed in 64 bits
+    */
+    template<class U = T>
+    _NODISCARD constexpr type_if<algorithms::sum_t<U>, algorithms::summable_v<U>> sum() const noexcept {
+        return algorithms::sum(_Unchecked_begin(), _Unchecked_end());
+    }
+
+    template<class Comp = comporator<void, less>>
+    _NODISCARD constexpr type_if<remove_const_t<T>, objects::is_ordering_v<util::invoke_result_t<Comp&, const_reference, const_reference>>> min(Comp&& comp = Comp{}) const {
+        return algorithms::min(_Unchecked_begin(), _Unchecked_end(), comp);
+    }
+
+    template<class Comp = comporator<void, less>>
+    _NODISCARD constexpr type_if<remove_const_t<T>, objects::is_ordering_v<util::invoke_result_t<Comp&, const_reference, const_reference>>> max(Comp&& comp = Comp{}) const {
+        return algorithms::max(_Unchecked_begin(), _Unchecked_end(), comp);
+    }
+
+    template<class Comp = comporator<void, less>>
+    _NODISCARD constexpr type_if<pair<remove_const_t<T>, remove_const_t<T>>, objects::is_ordering_v<util::invoke_result_t<Comp&, const_reference, const_reference>>> minmax(Comp&& comp = Comp{}) const {
+        return algorithms::minmax(_Unchecked_begin(), _Unchecked_end(), comp);
+    }
+
+    template<class Pred>
+    _NODISCARD constexpr type_if<size_type, convertible_v<util::invoke_result_t<Pred&, const_reference>, bool>> count_if(Pred&& pred) const {
+        return algorithms::count_if(_Unchecked_begin(), _Unchecked_end(), pred);
+    }
+
+    template<class Pred>
+    _NODISCARD constexpr type_if<bool, convertible_v<util::invoke_result_t<Pred&, const_reference>, bool>> any_of(Pred&& pred) const {
+        return algorithms::any_of(_Unchecked_begin(), _Unchecked_end(), pred);
+    }
+
+    template<class Pred>
+    _NODISCARD constexpr type_if<bool, convertible_v<util::invoke_result_t<Pred&, const_reference>, bool>> all_of(Pred&& pred) const {
+        return algorithms::all_of(_Unchecked_begin(), _Unchecked_end(), pred);
+    }
+
     template<class Comp = default_comporator, class U = T, class Ord = util::invoke_result_t<Comp, T const&, U const&>>
     _NODISCARD type_if<Ord, objects::is_ordering_v<Ord>> compare(array<U, N> const& other, Comp&& comp = Comp{}) const noexcept(util::nothrow_invocable_v<Comp, T const&, U const&>) {
         auto i = this->_Unchecked_begin();
@@ -548,11 +806,22 @@ template<class T, size_t N> struct array<T, N> {
     template<class... Args, class Proc = std::function<void(const_reference, Args...)>>
     constexpr type_if<size_type, util::invocable_v<Proc, const_reference, Args...>> rforeach(Proc&& proc, Args&&... args) const { return arrays::_rforeach(*this, static_cast<Proc&&>(proc), static_cast<Args&&>(args)...); }
 
+    template<class Policy, class Proc, class... Args>
+    type_if<size_type, execution::is_policy_v<Policy>, util::invocable_v<Proc&, reference, Args&...>> foreach(Policy&& policy, Proc&& proc, Args&&... args) { return arrays::_foreach(static_cast<Policy&&>(policy), *this, static_cast<Proc&&>(proc), static_cast<Args&&>(args)...); }
+
+    template<class Policy, class Proc, class... Args>
+    type_if<size_type, execution::is_policy_v<Policy>, util::invocable_v<Proc&, const_reference, Args&...>> foreach(Policy&& policy, Proc&& proc, Args&&... args) const { return arrays::_foreach(static_cast<Policy&&>(policy), *this, static_cast<Proc&&>(proc), static_cast<Args&&>(args)...); }
+
     template<class Mapper, class... Args, class U = util::invoke_result_t<Mapper, const_reference, Args...>>
     constexpr _NODISCARD type_if<array<U, N>, !is_same_v<void, U>> map(Mapper&& mapper, Args&&... args) const {
         return { arrays::_map{}, _Unchecked_begin(), mapper, static_cast<Args&&>(args)... };
     }
 
+    template<class Policy, class Mapper, class... Args, class U = util::invoke_result_t<Mapper&, const_reference, Args&...>>
+    _NODISCARD type_if<array<U, N>, execution::is_policy_v<Policy>, !is_same_v<void, U>> map(Policy&& policy, Mapper&& mapper, Args&&... args) const {
+        return arrays::map(static_cast<Policy&&>(policy), *this, mapper, args...);
+    }
+
     ~array() noexcept {
         objects::destroy_range(_Unchecked_begin(), _Unchecked_end());
     }
@@ -651,6 +920,85 @@ template<class T, size_t N, size_t M> struct array<T, N, M> : array<array<T, M>,
     _NODISCARD constexpr T const& at(size_type x, size_type y) const {
         return at(x).at(y);
     }
+
+    _NODISCARD constexpr array<T, M>& row(size_type x) noexcept {
+        return (*this)[x];
+    }
+
+    _NODISCARD constexpr array<T, M> const& row(size_type x) const noexcept {
+        return (*this)[x];
+    }
+
+    _NODISCARD mdspan<T, N> column(size_type y) noexcept {
+        return span().column(y);
+    }
+
+    _NODISCARD mdspan<T const, N> column(size_type y) const noexcept {
+        return span().column(y);
+    }
+
+    /**
+    * the Rows x Cols elements from (x, y); unchecked like operator[], asserted to fit in debug builds
+    */
+    template<size_t Rows, size_t Cols>
+    _NODISCARD mdspan<T, Rows, Cols> block(size_type x, size_type y) noexcept {
+        static_assert(Rows <= N && Cols <= M, "the block is out of range");
+        _STL_ASSERT(x <= N - Rows && y <= M - Cols, "array::block out of range");
+        return span().template block<Rows, Cols>(x, y);
+    }
+
+    template<size_t Rows, size_t Cols>
+    _NODISCARD mdspan<T const, Rows, Cols> block(size_type x, size_type y) const noexcept {
+        static_assert(Rows <= N && Cols <= M, "the block is out of range");
+        _STL_ASSERT(x <= N - Rows && y <= M - Cols, "array::block out of range");
+        return span().template block<Rows, Cols>(x, y);
+    }
+
+    _NODISCARD mdspan<T, dynamic_extent, dynamic_extent> block(size_type x, size_type y, size_type rows, size_type cols) noexcept {
+        _STL_ASSERT(x <= N && rows <= N - x && y <= M && cols <= M - y, "array::block out of range");
+        return span().block(x, y, rows, cols);
+    }
+
+    _NODISCARD mdspan<T const, dynamic_extent, dynamic_extent> block(size_type x, size_type y, size_type rows, size_type cols) const noexcept {
+        _STL_ASSERT(x <= N && rows <= N - x && y <= M && cols <= M - y, "array::block out of range");
+        return span().block(x, y, rows, cols);
+    }
+
+    /**
+    * the rows are laid out back to back, so the whole matrix is one strided view
+    */
+    _NODISCARD mdspan<T, N, M> span() noexcept {
+        return mdspan<T, N, M>::contiguous(reinterpret_cast<T*>(base::data()));
+    }
+
+    _NODISCARD mdspan<T const, N, M> span() const noexcept {
+        return mdspan<T const, N, M>::contiguous(reinterpret_cast<T const*>(base::data()));
+    }
+
+    /**
+    * a copy with rows and columns swapped, made tile by tile
+    */
+    template<class U = T>
+    _NODISCARD type_if<array<T, M, N>, is_copy_assignable_v<U>> transposed() const {
+        array<T, M, N> res;
+        algorithms::transpose(span().data(), N, M, ptrdiff_t(M), res.span().data(), ptrdiff_t(N));
+        return res;
+    }
+
+    template<class Policy, class U = T>
+    _NODISCARD type_if<array<T, M, N>, execution::is_policy_v<Policy>, is_copy_assignable_v<U>> transposed(Policy&& policy) const {
+        array<T, M, N> res;
+        algorithms::transpose(static_cast<Policy&&>(policy), span().data(), N, M, ptrdiff_t(M), res.span().data(), ptrdiff_t(N));
+        return res;
+    }
+
+    /**
+    * in place, square matrices only
+    */
+    template<size_t K = N, type_if<int, K == M, is_move_assignable_v<T>> = 0>
+    void transpose() {
+        algorithms::transpose(span().data(), N, ptrdiff_t(M));
+    }
 };
 
 template<class T, size_t N, size_t... M> struct array<T, N, M...> : array<array<T, M...>, N> {
@@ -668,6 +1016,14 @@ template<class T, size_t N, size_t... M> struct array<T, N, M...> : array<array<
     template<class... size_t> _NODISCARD auto const& at(size_type x, size_type y, size_t... z) const {
         return at(x).at(y, z...);
     }
+
+    _NODISCARD mdspan<T, N, M...> span() noexcept {
+        return mdspan<T, N, M...>::contiguous(reinterpret_cast<T*>(base::data()));
+    }
+
+    _NODISCARD mdspan<T const, N, M...> span() const noexcept {
+        return mdspan<T const, N, M...>::contiguous(reinterpret_cast<T const*>(base::data()));
+    }
 };
 
 template<class T> struct array<T> {
@@ -709,6 +1065,13 @@ template<class T> struct array<T> {
     array(size_type const n, V const& value) : array(_n_copies(n, value), n) {
     }
 
+    /**
+    * default-initializes n elements: the memory of trivially default constructible T is left as allocated
+    */
+    template<class Int = type_if<int, is_constructible_v<T>>, Int = 0>
+    array(arrays::for_overwrite_t, size_type const n) : array(_n_for_overwrite(n), n) {
+    }
+
     template<class I, type_if<int, iterators::fwd_iter_v<I>, is_constructible_v<T, decltype(*std::declval<I>())>> = 0>
     array(I begin, I end)
         : m_elems(nullptr), m_size(_init(m_elems, begin, end)) {
@@ -746,14 +1109,14 @@ template<class T> struct array<T> {
     }
 
     template<class U, type_if<int, is_constructible_v<T, U const&>> = 0>
-    array(size_type const size, U const* data) : array(_alloc(size), size) {
+    array(size_type const size, U const* data) : array(data ? _alloc(arrays::for_overwrite, size) : _alloc(size), size) {
         if (data)
             arrays::_copy_construct(m_elems, m_elems + size, data);
     }
 
     template<class U, type_if<int, is_constructible_v<T, U const&>> = 0>
     array(std::nothrow_t, size_type const size, U const* data) noexcept(is_nothrow_constructible_v<T, U const&>)
-        : m_elems(_alloc(std::nothrow, size)), m_size(m_elems ? size : 0) {
+        : m_elems(data ? _alloc(std::nothrow, arrays::for_overwrite, size) : _alloc(std::nothrow, size)), m_size(m_elems ? size : 0) {
         if (data)
             if (m_elems) arrays::_copy_construct(m_elems, m_elems + size, data);
     }
@@ -865,6 +1228,170 @@ template<class T> struct array<T> {
         return { crbegin(), crend() };
     }
 
+    /**
+    * @param [] comp - three-way ordering functor
+    */
+    template<class Comp = comporator<void, less>>
+    type_if<void, is_move_assignable_v<T>, objects::is_ordering_v<util::invoke_result_t<Comp&, const_reference, const_reference>>> sort(Comp&& comp = Comp{}) {
+        algorithms::sort(m_elems, m_elems + m_size, comp);
+    }
+
+    template<class Comp = comporator<void, less>>
+    type_if<void, is_move_assignable_v<T>, objects::is_ordering_v<util::invoke_result_t<Comp&, const_reference, const_reference>>> stable_sort(Comp&& comp = Comp{}) {
+        algorithms::stable_sort(m_elems, m_elems + m_size, comp);
+    }
+
+    /**
+    * @param [] policy - a parallel policy sorts chunks concurrently and merges them pairwise
+    * @param [] comp - three-way ordering functor
+    */
+    template<class Policy, class Comp = comporator<void, less>>
+    type_if<void, execution::is_policy_v<Policy>, is_move_assignable_v<T>, objects::is_ordering_v<util::invoke_result_t<Comp&, const_reference, const_reference>>>
+        sort(Policy&& policy, Comp&& comp = Comp{}) {
+        algorithms::sort(static_cast<Policy&&>(policy), m_elems, m_elems + m_size, comp);
+    }
+
+    template<class Policy, class Comp = comporator<void, less>>
+    type_if<void, execution::is_policy_v<Policy>, is_move_assignable_v<T>, objects::is_ordering_v<util::invoke_result_t<Comp&, const_reference, const_reference>>>
+        stable_sort(Policy&& policy, Comp&& comp = Comp{}) {
+        algorithms::stable_sort(static_cast<Policy&&>(policy), m_elems, m_elems + m_size, comp);
+    }
+
+    /**
+    * @param [] value - searched in the array sorted by comp
+    * @param [] comp - three-way ordering functor
+    * @return the index of the first element not less than value
+    */
+    template<class U = T, class Comp = comporator<void, less>>
+    _NODISCARD type_if<size_type, objects::is_ordering_v<util::invoke_result_t<Comp&, const_reference, U const&>>> lower_bound(U const& value, Comp&& comp = Comp{}) const {
+        return algorithms::lower_bound(_Unchecked_begin(), _Unchecked_end(), value, comp);
+    }
+
+    /**
+    * @return the index of the first element greater than value
+    */
+    template<class U = T, class Comp = comporator<void, less>>
+    _NODISCARD type_if<size_type, objects::is_ordering_v<util::invoke_result_t<Comp&, U const&, const_reference>>> upper_bound(U const& value, Comp&& comp = Comp{}) const {
+        return algorithms::upper_bound(_Unchecked_begin(), _Unchecked_end(), value, comp);
+    }
+
+    template<class U = T, class Comp = comporator<void, less>>
+    _NODISCARD type_if<pair<size_type, size_type>, objects::is_ordering_v<util::invoke_result_t<Comp&, const_reference, U const&>>, objects::is_ordering_v<util::invoke_result_t<Comp&, U const&, const_reference>>>
+        equal_range(U const& value, Comp&& comp = Comp{}) const {
+        return algorithms::equal_range(_Unchecked_begin(), _Unchecked_end(), value, comp);
+    }
+
+    template<class U = T, class Comp = comporator<void, less>>
+    _NODISCARD type_if<bool, objects::is_ordering_v<util::invoke_result_t<Comp&, const_reference, U const&>>, objects::is_ordering_v<util::invoke_result_t<Comp&, U const&, const_reference>>>
+        contains(U const& value, Comp&& comp = Comp{}) const {
+        return algorithms::contains(_Unchecked_begin(), _Unchecked_end(), value, comp);
+    }
+
+    /**
+    * lower_bound of each of values, the searches interleaved to overlap their cache misses
+    */
+    template<class U, class Comp = comporator<void, less>>
+    _NODISCARD type_if<array<size_type>, objects::is_ordering_v<util::invoke_result_t<Comp&, const_reference, U const&>>> lower_bound_many(array<U> const& values, Comp&& comp = Comp{}) const {
+        return arrays::_lower_bound_many(*this, values, comp);
+    }
+
+    template<class U, size_t K, class Comp = comporator<void, less>>
+    _NODISCARD type_if<array<size_type, K>, (K > 0), objects::is_ordering_v<util::invoke_result_t<Comp&, const_reference, U const&>>> lower_bound_many(array<U, K> const& values, Comp&& comp = Comp{}) const {
+        return arrays::_lower_bound_many(*this, values, comp);
+    }
+
+    /**
+    * left fold of the elements
+    */
+    template<class Init, class Op>
+    _NODISCARD type_if<Init, convertible_v<util::invoke_result_t<Op&, Init&&, const_reference>, Init>> reduce(Init init, Op&& op) const {
+        return algorithms::reduce(_Unchecked_begin(), _Unchecked_end(), static_cast<Init&&>(init), op);
+    }
+
+    /**
+    * deterministic multi-accumulator sum, integers are summed in 64 bits
+    */
+    template<class U = T>
+    _NODISCARD type_if<algorithms::sum_t<U>, algorithms::summable_v<U>> sum() const noexcept {
+        return algorithms::sum(_Unchecked_begin(), _Unchecked_end());
+    }
+
+    template<class Comp = comporator<void, less>>
+    _NODISCARD type_if<optional<remove_const_t<T>>, objects::is_ordering_v<util::invoke_result_t<Comp&, const_reference, const_reference>>> min(Comp&& comp = Comp{}) const {
+        if (empty()) return {};
+        return algorithms::min(_Unchecked_begin(), _Unchecked_end(), comp);
+    }
+
+    template<class Comp = comporator<void, less>>
+    _NODISCARD type_if<optional<remove_const_t<T>>, objects::is_ordering_v<util::invoke_result_t<Comp&, const_reference, const_reference>>> max(Comp&& comp = Comp{}) const {
+        if (empty()) return {};
+        return algorithms::max(_Unchecked_begin(), _Unchecked_end(), comp);
+    }
+
+    template<class Comp = comporator<void, less>>
+    _NODISCARD type_if<optional<pair<remove_const_t<T>, remove_const_t<T>>>, objects::is_ordering_v<util::invoke_result_t<Comp&, const_reference, const_reference>>> minmax(Comp&& comp = Comp{}) const {
+        if (empty()) return {};
+        return algorithms::minmax(_Unchecked_begin(), _Unchecked_end(), comp);
+    }
+
+    template<class Pred>
+    _NODISCARD type_if<size_type, convertible_v<util::invoke_result_t<Pred&, const_reference>, bool>> count_if(Pred&& pred) const {
+        return algorithms::count_if(_Unchecked_begin(), _Unchecked_end(), pred);
+    }
+
+    template<class Pred>
+    _NODISCARD type_if<bool, convertible_v<util::invoke_result_t<Pred&, const_reference>, bool>> any_of(Pred&& pred) const {
+        return algorithms::any_of(_Unchecked_begin(), _Unchecked_end(), pred);
+    }
+
+    template<class Pred>
+    _NODISCARD type_if<bool, convertible_v<util::invoke_result_t<Pred&, const_reference>, bool>> all_of(Pred&& pred) const {
+        return algorithms::all_of(_Unchecked_begin(), _Unchecked_end(), pred);
+    }
+
+    /**
+    * @param [] op - associative: blocks are folded concurrently and combined in order
+    */
+    template<class Policy, class Init, class Op>
+    _NODISCARD type_if<Init, execution::is_policy_v<Policy>, is_constructible_v<Init, const_reference>, convertible_v<util::invoke_result_t<Op&, Init&&, const_reference>, Init>,
+        convertible_v<util::invoke_result_t<Op&, Init&&, Init&&>, Init>> reduce(Policy&& policy, Init init, Op&& op) const {
+        return algorithms::reduce(static_cast<Policy&&>(policy), _Unchecked_begin(), _Unchecked_end(), static_cast<Init&&>(init), op);
+    }
+
+    /**
+    * equal bit for bit to sum()
+    */
+    template<class Policy, class U = T>
+    _NODISCARD type_if<algorithms::sum_t<U>, execution::is_policy_v<Policy>, algorithms::summable_v<U>> sum(Policy&& policy) const {
+        return algorithms::sum(static_cast<Policy&&>(policy), _Unchecked_begin(), _Unchecked_end());
+    }
+
+    template<class Policy, class Comp = comporator<void, less>>
+    _NODISCARD type_if<optional<remove_const_t<T>>, execution::is_policy_v<Policy>, objects::is_ordering_v<util::invoke_result_t<Comp&, const_reference, const_reference>>>
+        min(Policy&& policy, Comp&& comp = Comp{}) const {
+        if (empty()) return {};
+        return algorithms::min(static_cast<Policy&&>(policy), _Unchecked_begin(), _Unchecked_end(), comp);
+    }
+
+    template<class Policy, class Comp = comporator<void, less>>
+    _NODISCARD type_if<optional<remove_const_t<T>>, execution::is_policy_v<Policy>, objects::is_ordering_v<util::invoke_result_t<Comp&, const_reference, const_reference>>>
+        max(Policy&& policy, Comp&& comp = Comp{}) const {
+        if (empty()) return {};
+        return algorithms::max(static_cast<Policy&&>(policy), _Unchecked_begin(), _Unchecked_end(), comp);
+    }
+
+    template<class Policy, class Comp = comporator<void, less>>
+    _NODISCARD type_if<optional<pair<remove_const_t<T>, remove_const_t<T>>>, execution::is_policy_v<Policy>, objects::is_ordering_v<util::invoke_result_t<Comp&, const_reference, const_reference>>>
+        minmax(Policy&& policy, Comp&& comp = Comp{}) const {
+        if (empty()) return {};
+        return algorithms::minmax(static_cast<Policy&&>(policy), _Unchecked_begin(), _Unchecked_end(), comp);
+    }
+
+    template<class Policy, class Pred>
+    _NODISCARD type_if<size_type, execution::is_policy_v<Policy>, convertible_v<util::invoke_result_t<Pred&, const_reference>, bool>> count_if(Policy&& policy, Pred&& pred) const {
+        return algorithms::count_if(static_cast<Policy&&>(policy), _Unchecked_begin(), _Unchecked_end(), pred);
+    }
+
     template<class Filter>
     _NODISCARD type_if<array, convertible_v<util::invoke_result_t<Filter, const_reference>, bool>> filtered(Filter&& filter) const {
         return { _Unchecked_begin(), _Unchecked_end(), static_cast<Filter&&>(filter) };
@@ -894,6 +1421,22 @@ template<class T> struct array<T> {
     template<class... Args, class Proc = std::function<void(const_reference, Args...)>>
     type_if<size_type, util::invocable_v<Proc, const_reference, Args...>> rforeach(Proc&& proc, Args&&... args) const { return arrays::_rforeach(*this, static_cast<Proc&&>(proc), static_cast<Args&&>(args)...); }
 
+    template<class Policy, class Proc, class... Args>
+    type_if<size_type, execution::is_policy_v<Policy>, util::invocable_v<Proc&, reference, Args&...>> foreach(Policy&& policy, Proc&& proc, Args&&... args) { return arrays::_foreach(static_cast<Policy&&>(policy), *this, static_cast<Proc&&>(proc), static_cast<Args&&>(args)...); }
+
+    template<class Policy, class Proc, class... Args>
+    type_if<size_type, execution::is_policy_v<Policy>, util::invocable_v<Proc&, const_reference, Args&...>> foreach(Policy&& policy, Proc&& proc, Args&&... args) const { return arrays::_foreach(static_cast<Policy&&>(policy), *this, static_cast<Proc&&>(proc), static_cast<Args&&>(args)...); }
+
+    template<class Mapper, class... Args, class U = util::invoke_result_t<Mapper, const_reference, Args...>>
+    _NODISCARD type_if<array<U>, !execution::is_policy_v<Mapper>, !is_same_v<void, U>> map(Mapper&& mapper, Args&&... args) const {
+        return arrays::_map_n<U>(execution::seq, size(), _Unchecked_begin(), mapper, static_cast<Args&&>(args)...);
+    }
+
+    template<class Policy, class Mapper, class... Args, class U = util::invoke_result_t<Mapper&, const_reference, Args&...>>
+    _NODISCARD type_if<array<U>, execution::is_policy_v<Policy>, !is_same_v<void, U>> map(Policy&& policy, Mapper&& mapper, Args&&... args) const {
+        return arrays::_map_n<U>(static_cast<Policy&&>(policy), size(), _Unchecked_begin(), mapper, args...);
+    }
+
 protected:
     remove_const_t<T>* m_elems;
     size_type m_size;
@@ -919,11 +1462,21 @@ protected:
     }
 
     template<class... Args> static remove_const_t<T>* _n_copies(size_type const size, Args&&... args) {
-        auto* const data = new _bytes<false>[size];
+        auto* const data = _alloc(arrays::for_overwrite, size);
         for (auto i = data, end = data + size; i != end; ++i) {
             new(i) T(static_cast<Args&&>(args)...);
         }
-        return (remove_const_t<T>*) data;
+        return data;
+    }
+
+    static remove_const_t<T>* _n_for_overwrite(size_type const size) {
+        auto* const data = _alloc(arrays::for_overwrite, size);
+        if (!std::is_trivially_default_constructible<T>::value) {
+            for (auto i = data, end = data + size; i != end; ++i) {
+                new(i) T;
+            }
+        }
+        return data;
     }
 
     static remove_const_t<T>* _alloc(size_type const size) {
@@ -934,6 +1487,14 @@ protected:
         return (remove_const_t<T>*) new(std::nothrow) _bytes<true>[size];
     }
 
+    static remove_const_t<T>* _alloc(arrays::for_overwrite_t, size_type const size) {
+        return (remove_const_t<T>*) new _bytes<false>[size];
+    }
+
+    static remove_const_t<T>* _alloc(std::nothrow_t, arrays::for_overwrite_t, size_type const size) noexcept {
+        return (remove_const_t<T>*) new(std::nothrow) _bytes<false>[size];
+    }
+
     static void _free(T* ptr) noexcept {
         delete[]((_bytes<true>*)ptr);
     }
@@ -953,7 +1514,7 @@ protected:
             I cur = iterator;
             if (cur == end) {
                 if (size) {
-                    res_data = _alloc(size);
+                    res_data = _alloc(arrays::for_overwrite, size);
                 }
                 return;
             }
@@ -977,7 +1538,7 @@ protected:
         void operator()() {
             res_size = end - begin;
             if (res_size) {
-                res_data = _alloc(res_size);
+                res_data = _alloc(arrays::for_overwrite, res_size);
                 for (remove_const_t<T>* i = res_data; begin != end; ++i, (void)++begin) {
                     new(i) T(*begin);
                 }
@@ -1006,7 +1567,7 @@ protected:
             auto const n = res_size;
             if (iterator == end) {
                 if (n) {
-                    res_data = _alloc(n);
+                    res_data = _alloc(arrays::for_overwrite, n);
                 }
                 return;
             }
@@ -1036,12 +1597,32 @@ protected:
         constexpr void operator()() noexcept {}
     };
 
-    template<class I, class Filter> static size_type _filtered(remove_const_t<T>*& res_data, I iterator, I end, Filter& filter) {
+    template<class I, class Filter> static size_type _filtered(remove_const_t<T>*& res_data, I iterator, I end, Filter& filter, false_type) {
         size_type res_size = 0;
         _init_filtered<I, Filter>{ res_data, res_size, iterator, end, filter }();
         return res_size;
     }
 
+    /**
+    * contiguous trivially copyable source: a mask pre-pass sizes the single allocation, then the survivors are compacted
+    */
+    template<class I, class Filter> static size_type _filtered(remove_const_t<T>*& res_data, I begin, I end, Filter& filter, true_type) {
+        std::unique_ptr<uint64_t[]> const masks(new uint64_t[(size_t(end - begin) + 63) / 64]);
+        size_type const res_size = algorithms::select_mask(begin, end, masks.get(), filter);
+        if (res_size) {
+            res_data = _alloc(arrays::for_overwrite, res_size);
+            algorithms::compress(begin, end, masks.get(), res_data, res_size);
+        }
+        return res_size;
+    }
+
+    template<class I, class Filter> using _compactable = conditional<std::is_pointer<I>::value && std::is_trivially_copyable<T>::value &&
+        is_same_v<remove_cvref_t<decltype(*std::declval<I>())>, remove_const_t<T>> && !is_same_v<Filter, always_true> && !is_same_v<Filter, always_false>>;
+
+    template<class I, class Filter> static size_type _filtered(remove_const_t<T>*& res_data, I iterator, I end, Filter& filter) {
+        return _filtered(res_data, iterator, end, filter, _compactable<I, Filter>{});
+    }
+
     template<class, size_t...> friend struct array;
 };
 
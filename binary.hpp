@@ -0,0 +1,380 @@
+#ifndef __BINARY_HPP
+#define __BINARY_HPP 1
+
+#include "util.hpp"
+#include "object.hpp"
+#include "pair.hpp"
+#include "optional.hpp"
+#include "array.hpp"
+#include "front_linked_list.hpp"
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <memory>
+#include <ostream>
+#include <type_traits>
+#include <vector>
+
+#if defined(_WIN32)
+#include <io.h>
+#else
+#include <climits>
+#include <sys/uio.h>
+#include <unistd.h>
+#endif // _WIN32
+
+/**
+* compact binary format: a header (magic, format version, caller's schema) followed by the values,
+* containers prefixed by their length; contiguous trivially copyable elements are copied in bulk.
+* The byte order is the host's, a mismatch is detected by the header.
+*/
+struct binary {
+    constexpr _INLINE_VAR static uint32_t magic = 0x4E494231;
+    constexpr _INLINE_VAR static uint32_t version = 1;
+
+    /**
+    * buffers small writes, bulk ones bypass the buffer
+    */
+    struct stream_writer {
+        explicit stream_writer(std::ostream& os, size_t const capacity = size_t(1) << 16)
+            : m_os(os), m_buffer(new char[capacity]), m_capacity(capacity), m_size(0) {
+        }
+
+        stream_writer(stream_writer const&) = delete;
+        stream_writer& operator=(stream_writer const&) = delete;
+
+        ~stream_writer() { flush(); }
+
+        void put(void const* const data, size_t const n) {
+            if (!n) return;
+            if (m_capacity - m_size < n) {
+                flush();
+                if (n >= m_capacity) {
+                    m_os.write(static_cast<char const*>(data), std::streamsize(n));
+                    return;
+                }
+            }
+            std::memcpy(m_buffer.get() + m_size, data, n);
+            m_size += n;
+        }
+
+        void put_bulk(void const* const data, size_t const n) { put(data, n); }
+
+        void flush() {
+            if (m_size) m_os.write(m_buffer.get(), std::streamsize(m_size));
+            m_size = 0;
+        }
+
+    protected:
+        std::ostream& m_os;
+        std::unique_ptr<char[]> m_buffer;
+        size_t m_capacity;
+        size_t m_size;
+    };
+
+    /**
+    * collects the output as a list of segments written at once by writev: bulk data is referenced in place,
+    * so it must outlive the writer; small writes are copied into blocks owned by the writer
+    */
+    struct gather_writer {
+        /**
+        * bulk data shorter than this is copied rather than referenced
+        */
+        constexpr _INLINE_VAR static size_t inline_threshold = 1024;
+
+        gather_writer() noexcept : m_used(_block) {}
+
+        gather_writer(gather_writer const&) = delete;
+        gather_writer& operator=(gather_writer const&) = delete;
+
+        void put(void const* const data, size_t const n) {
+            if (!n) return;
+            if (_block - m_used < n) {
+                m_blocks.emplace_back(new char[n > _block ? n : _block]);
+                m_used = 0;
+            }
+            char* const dst = m_blocks.back().get() + m_used;
+            std::memcpy(dst, data, n);
+            m_used = n > _block ? _block : m_used + n;
+            if (!m_segments.empty() && static_cast<char const*>(m_segments.back().data) + m_segments.back().size == dst) m_segments.back().size += n;
+            else m_segments.push_back({ dst, n });
+        }
+
+        void put_bulk(void const* const data, size_t const n) {
+            if (n < inline_threshold) put(data, n);
+            else m_segments.push_back({ data, n });
+        }
+
+        _NODISCARD size_t size() const noexcept {
+            size_t res = 0;
+            for (auto const& segment : m_segments) res += segment.size;
+            return res;
+        }
+
+        /**
+        * @param [] fd - a file descriptor open for writing
+        * @return false if a write failed, errno tells why
+        */
+        bool flush(int const fd) {
+#if defined(_WIN32)
+            for (auto const& segment : m_segments) {
+                for (size_t done = 0; done != segment.size; ) {
+                    size_t const left = segment.size - done;
+                    int const written = _write(fd, static_cast<char const*>(segment.data) + done, unsigned(left < 0x40000000 ? left : 0x40000000));
+                    if (written < 0) return false;
+                    done += size_t(written);
+                }
+            }
+#else
+            std::vector<iovec> iov(m_segments.size());
+            for (size_t i = 0; i != m_segments.size(); ++i) iov[i] = { const_cast<void*>(m_segments[i].data), m_segments[i].size };
+            for (size_t first = 0; first != iov.size(); ) {
+                size_t const count = iov.size() - first < size_t(IOV_MAX) ? iov.size() - first : size_t(IOV_MAX);
+                ssize_t written = ::writev(fd, iov.data() + first, int(count));
+                if (written < 0) return false;
+                for (; first != iov.size() && size_t(written) >= iov[first].iov_len; ++first) written -= ssize_t(iov[first].iov_len);
+                if (first != iov.size()) {
+                    iov[first].iov_base = static_cast<char*>(iov[first].iov_base) + written;
+                    iov[first].iov_len -= size_t(written);
+                }
+            }
+#endif // _WIN32
+            m_segments.clear();
+            m_blocks.clear();
+            m_used = _block;
+            return true;
+        }
+
+    protected:
+        constexpr _INLINE_VAR static size_t _block = size_t(1) << 16;
+
+        struct _segment {
+            void const* data;
+            size_t size;
+        };
+
+        std::vector<_segment> m_segments;
+        std::vector<std::unique_ptr<char[]>> m_blocks;
+        size_t m_used;
+    };
+
+    struct stream_reader {
+        explicit stream_reader(std::istream& is) noexcept : m_is(is) {}
+
+        void get(void* const data, size_t const n) {
+            m_is.read(static_cast<char*>(data), std::streamsize(n));
+            if (size_t(m_is.gcount()) != n)
+                std::_Xruntime_error("binary: unexpected end of input");
+        }
+
+    protected:
+        std::istream& m_is;
+    };
+
+    /**
+    * reads from memory, e.g. a mapped_array<char>
+    */
+    struct memory_reader {
+        memory_reader(void const* const data, size_t const size) noexcept
+            : m_cur(static_cast<char const*>(data)), m_end(static_cast<char const*>(data) + size) {
+        }
+
+        void get(void* const data, size_t const n) {
+            if (size_t(m_end - m_cur) < n)
+                std::_Xruntime_error("binary: unexpected end of input");
+            if (!n) return;
+            std::memcpy(data, m_cur, n);
+            m_cur += n;
+        }
+
+        _NODISCARD size_t remaining() const noexcept { return size_t(m_end - m_cur); }
+
+    protected:
+        char const* m_cur;
+        char const* m_end;
+    };
+
+    template<class W> static void write_header(W& w, uint32_t const schema = 0) {
+        uint32_t const header[] = { magic, version, schema };
+        w.put(header, sizeof header);
+    }
+
+    /**
+    * @return the schema the data was written with
+    */
+    template<class R> static uint32_t read_header(R& r) {
+        uint32_t header[3];
+        r.get(header, sizeof header);
+        if (header[0] != magic)
+            std::_Xruntime_error("binary: not a binary stream or foreign byte order");
+        if (header[1] > version)
+            std::_Xruntime_error("binary: unsupported format version");
+        return header[2];
+    }
+
+    /**
+    * @param [] value - trivially copyable, array, pair, optional or front_linked_list, nested arbitrarily
+    */
+    template<class W, class T> static void write(W& w, T const& value) { _write(w, value); }
+
+    /**
+    * @param [out] value - overwritten; elements of containers have to be default constructible
+    */
+    template<class R, class T> static void read(R& r, T& value) { _read(r, value); }
+
+    template<class T> static void save(std::ostream& os, T const& value, uint32_t const schema = 0) {
+        stream_writer w(os);
+        write_header(w, schema);
+        _write(w, value);
+    }
+
+    /**
+    * @return the schema the data was written with
+    */
+    template<class T> static uint32_t load(std::istream& is, T& value) {
+        stream_reader r(is);
+        uint32_t const schema = read_header(r);
+        _read(r, value);
+        return schema;
+    }
+
+protected:
+    template<class T> struct _bulk : conditional<std::is_trivially_copyable<T>::value && !std::is_pointer<T>::value> {};
+
+    template<class T, size_t N> struct _bulk<array<T, N>> : conditional<N != 0 && _bulk<T>::value && sizeof(array<T, N>) == sizeof(T) * N> {};
+
+    template<class T, size_t N, size_t M, size_t... K> struct _bulk<array<T, N, M, K...>> : _bulk<array<array<T, M, K...>, N>> {};
+
+    template<class T> using _raw = conditional<std::is_trivially_copyable<T>::value && !std::is_pointer<T>::value>;
+
+    template<class W> static void _write_count(W& w, size_t const n) {
+        uint64_t const count = n;
+        w.put(&count, sizeof count);
+    }
+
+    template<class R> static size_t _read_count(R& r) {
+        uint64_t count;
+        r.get(&count, sizeof count);
+        return size_t(count);
+    }
+
+    template<class W, class T> static void _write_n(W& w, T const* const data, size_t const n, true_type) { w.put_bulk(data, n * sizeof(T)); }
+
+    template<class W, class T> static void _write_n(W& w, T const* const data, size_t const n, false_type) {
+        for (size_t i = 0; i != n; ++i) _write(w, data[i]);
+    }
+
+    template<class R, class T> static void _read_n(R& r, T* const data, size_t const n, true_type) { r.get(data, n * sizeof(T)); }
+
+    template<class R, class T> static void _read_n(R& r, T* const data, size_t const n, false_type) {
+        for (size_t i = 0; i != n; ++i) _read(r, data[i]);
+    }
+
+    template<class W, class T> static type_if<void, _raw<T>::value> _write(W& w, T const& value) { w.put(std::addressof(value), sizeof(T)); }
+
+    template<class R, class T> static type_if<void, _raw<T>::value> _read(R& r, T& value) { r.get(std::addressof(value), sizeof(T)); }
+
+    template<class W, class A, class B> static void _write(W& w, pair<A, B> const& value) {
+        _write(w, value.first);
+        _write(w, value.second);
+    }
+
+    template<class R, class A, class B> static void _read(R& r, pair<A, B>& value) {
+        _read(r, value.first);
+        _read(r, value.second);
+    }
+
+    template<class W, class T> static void _write(W& w, optional<T> const& value) {
+        uint8_t const present = value.has_value();
+        w.put(&present, 1);
+        if (present) _write(w, *value);
+    }
+
+    template<class R, class T> static void _read(R& r, optional<T>& value) {
+        uint8_t present;
+        r.get(&present, 1);
+        if (!present) {
+            value.reset();
+            return;
+        }
+        T elem{};
+        _read(r, elem);
+        value = optional<T>(static_cast<T&&>(elem));
+    }
+
+    /**
+    * matches array<T, N, M...> too, through its base array<array<T, M...>, N>
+    */
+    template<class W, class T, size_t N> static void _write(W& w, array<T, N> const& arr) {
+        _write_count(w, N);
+        _write_n(w, arr.data(), N, _bulk<T>{});
+    }
+
+    template<class R, class T, size_t N> static void _read(R& r, array<T, N>& arr) {
+        if (_read_count(r) != N)
+            std::_Xruntime_error("binary: array extent mismatch");
+        _read_n(r, arr.data(), N, _bulk<T>{});
+    }
+
+    template<class W, class T> static void _write(W& w, array<T> const& arr) {
+        _write_count(w, arr.size());
+        _write_n(w, arr.data(), arr.size(), _bulk<T>{});
+    }
+
+    /**
+    * the count read is not trusted: checked against the bytes left when the reader knows them,
+    * else the storage grows by doubling from _batch<T> as the elements arrive
+    */
+    template<class R, class T> static void _read(R& r, array<T>& arr) {
+        size_t const n = _read_count(r);
+        size_t const remaining = _remaining(r, 0);
+        if (remaining != size_t(-1) && n > remaining / (_bulk<T>::value ? sizeof(T) : 1))
+            std::_Xruntime_error("binary: count exceeds the input");
+        size_t done = remaining != size_t(-1) || n < _batch<T> ? n : _batch<T>;
+        array<T> res = _read_array<T>(done, _bulk<T>{});
+        _read_n(r, res.data(), done, _bulk<T>{});
+        while (done != n) {
+            size_t const size = n - done < done ? n : done * 2;
+            array<T> grown = _read_array<T>(size, _bulk<T>{});
+            for (size_t i = 0; i != done; ++i) grown.data()[i] = static_cast<T&&>(res.data()[i]);
+            _read_n(r, grown.data() + done, size - done, _bulk<T>{});
+            res.swap(grown);
+            done = size;
+        }
+        arr.swap(res);
+    }
+
+    /**
+    * the elements read at once while a count is unchecked, about 1 MiB
+    */
+    template<class T> constexpr _INLINE_VAR static size_t _batch = sizeof(T) < (size_t(1) << 20) ? (size_t(1) << 20) / sizeof(T) : 1;
+
+    /**
+    * the bytes left if the reader tells them, else size_t(-1); every element read takes at least one byte
+    */
+    template<class R> static auto _remaining(R const& r, int) noexcept -> decltype(size_t(r.remaining())) { return r.remaining(); }
+
+    template<class R> static size_t _remaining(R const&, long) noexcept { return size_t(-1); }
+
+    template<class T> static array<T> _read_array(size_t const n, true_type) { return { arrays::for_overwrite, n }; }
+
+    template<class T> static array<T> _read_array(size_t const n, false_type) { return array<T>(n); }
+
+    template<class W, class T> static void _write(W& w, front_linked_list<T> const& list) {
+        size_t n = 0;
+        for (auto i = list.begin(), end = list.end(); i != end; ++i) ++n;
+        _write_count(w, n);
+        for (auto i = list.begin(), end = list.end(); i != end; ++i) _write(w, *i);
+    }
+
+    template<class R, class T> static void _read(R& r, front_linked_list<T>& list) {
+        list.clear();
+        auto last = list.before_begin();
+        for (size_t n = _read_count(r); n != 0; --n) {
+            last = list.emplace_after(last);
+            _read(r, *last);
+        }
+    }
+};
+
+#endif // !__BINARY_HPP
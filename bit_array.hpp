@@ -0,0 +1,368 @@
+#ifndef __BIT_ARRAY_HPP
+#define __BIT_ARRAY_HPP 1
+
+#include "util.hpp"
+#include "object.hpp"
+#include "array.hpp"
+#include "algorithm.hpp"
+#include <cstdint>
+#include <iterator>
+
+template<size_t...> struct bit_array;
+
+/**
+* word-level kernels over bits packed 64 to a uint64_t, lowest bit first; the bits past the size in the last word are kept 0
+*/
+struct bits {
+    using word = uint64_t;
+
+    constexpr _INLINE_VAR static size_t word_bits = 64;
+
+    constexpr _INLINE_VAR static size_t npos = size_t(-1);
+
+    _NODISCARD constexpr static size_t words(size_t const n) noexcept { return (n + word_bits - 1) / word_bits; }
+
+    /**
+    * the valid bits of the last of the words holding n bits
+    */
+    _NODISCARD constexpr static word tail_mask(size_t const n) noexcept { return n % word_bits ? (word(1) << (n % word_bits)) - 1 : ~word(0); }
+
+    _NODISCARD static size_t count(word const* const data, size_t const n) noexcept {
+        size_t res = 0;
+        for (size_t i = 0; i != n; ++i) res += size_t(algorithms::popcount(data[i]));
+        return res;
+    }
+
+    /**
+    * @return the index of the first set bit at or after pos, npos if none
+    */
+    _NODISCARD static size_t find_next(word const* const data, size_t const n, size_t const pos) noexcept {
+        size_t i = pos / word_bits;
+        if (i >= n) return npos;
+        word w = data[i] & (~word(0) << (pos % word_bits));
+        for (; !w; w = data[i]) {
+            if (++i == n) return npos;
+        }
+        return i * word_bits + size_t(algorithms::countr_zero(w));
+    }
+
+    /**
+    * plain loops over whole words, vectorized by the compiler
+    */
+    static void assign_and(word* const dst, word const* const src, size_t const n) noexcept {
+        for (size_t i = 0; i != n; ++i) dst[i] &= src[i];
+    }
+
+    static void assign_or(word* const dst, word const* const src, size_t const n) noexcept {
+        for (size_t i = 0; i != n; ++i) dst[i] |= src[i];
+    }
+
+    static void assign_xor(word* const dst, word const* const src, size_t const n) noexcept {
+        for (size_t i = 0; i != n; ++i) dst[i] ^= src[i];
+    }
+
+    static void flip(word* const data, size_t const n) noexcept {
+        for (size_t i = 0; i != n; ++i) data[i] = ~data[i];
+    }
+
+    _NODISCARD static bool equal(word const* const l, word const* const r, size_t const n) noexcept {
+        word diff = 0;
+        for (size_t i = 0; i != n; ++i) diff |= l[i] ^ r[i];
+        return diff == 0;
+    }
+
+    /**
+    * stands for a single bit
+    */
+    struct reference {
+        constexpr reference(word& w, word const mask) noexcept : m_word(&w), m_mask(mask) {}
+
+        constexpr operator bool() const noexcept { return (*m_word & m_mask) != 0; }
+
+        reference const& operator=(bool const value) const noexcept {
+            if (value) *m_word |= m_mask;
+            else *m_word &= ~m_mask;
+            return *this;
+        }
+
+        reference const& operator=(reference const& other) const noexcept { return *this = bool(other); }
+
+        reference const& flip() const noexcept {
+            *m_word ^= m_mask;
+            return *this;
+        }
+
+    protected:
+        word* m_word;
+        word m_mask;
+    };
+
+    /**
+    * walks the indices of the set bits, a word at a time
+    */
+    struct set_bit_iterator {
+        using value_type = size_t;
+        using difference_type = ptrdiff_t;
+        using pointer = size_t const*;
+        using reference = size_t;
+        using iterator_category = std::forward_iterator_tag;
+
+        constexpr set_bit_iterator() noexcept : m_data(nullptr), m_words(0), m_pos(npos) {}
+
+        set_bit_iterator(word const* const data, size_t const n, size_t const pos) noexcept
+            : m_data(data), m_words(n), m_pos(find_next(data, n, pos)) {
+        }
+
+        _NODISCARD size_t operator*() const noexcept { return m_pos; }
+
+        set_bit_iterator& operator++() noexcept {
+            m_pos = find_next(m_data, m_words, m_pos + 1);
+            return *this;
+        }
+
+        set_bit_iterator operator++(int) noexcept {
+            set_bit_iterator res = *this;
+            ++*this;
+            return res;
+        }
+
+        _NODISCARD bool operator==(set_bit_iterator const& other) const noexcept { return m_pos == other.m_pos; }
+
+        _NODISCARD bool operator!=(set_bit_iterator const& other) const noexcept { return m_pos != other.m_pos; }
+
+    protected:
+        word const* m_data;
+        size_t m_words;
+        size_t m_pos;
+    };
+
+    struct set_bit_range {
+        _NODISCARD set_bit_iterator begin() const noexcept { return m_begin; }
+
+        _NODISCARD set_bit_iterator end() const noexcept { return {}; }
+
+        set_bit_iterator m_begin;
+    };
+
+protected:
+    /**
+    * the interface shared by the fixed and the dynamic bit_array; Derived provides _words() and size()
+    */
+    template<class Derived> struct _ops {
+        using value_type = bool;
+        using size_type = size_t;
+        using reference = bits::reference;
+        using const_reference = bool;
+
+        _NODISCARD size_type word_count() const noexcept { return words(_self().size()); }
+
+        _NODISCARD word* data() noexcept { return _self()._words(); }
+
+        _NODISCARD word const* data() const noexcept { return _self()._words(); }
+
+        _NODISCARD bool test(size_type const pos) const noexcept { return (data()[pos / word_bits] >> (pos % word_bits)) & 1; }
+
+        _NODISCARD bool operator[](size_type const pos) const noexcept { return test(pos); }
+
+        _NODISCARD reference operator[](size_type const pos) noexcept { return { data()[pos / word_bits], word(1) << (pos % word_bits) }; }
+
+        _NODISCARD bool at(size_type const pos) const {
+            _check(pos);
+            return test(pos);
+        }
+
+        _NODISCARD reference at(size_type const pos) {
+            _check(pos);
+            return (*this)[pos];
+        }
+
+        Derived& set(size_type const pos, bool const value = true) noexcept {
+            (*this)[pos] = value;
+            return _self();
+        }
+
+        Derived& reset(size_type const pos) noexcept { return set(pos, false); }
+
+        Derived& flip(size_type const pos) noexcept {
+            data()[pos / word_bits] ^= word(1) << (pos % word_bits);
+            return _self();
+        }
+
+        Derived& fill(bool const value) noexcept {
+            size_t const n = word_count();
+            word* const w = data();
+            for (size_t i = 0; i != n; ++i) w[i] = value ? ~word(0) : 0;
+            return _trim();
+        }
+
+        Derived& flip() noexcept {
+            bits::flip(data(), word_count());
+            return _trim();
+        }
+
+        _NODISCARD size_type count() const noexcept { return bits::count(data(), word_count()); }
+
+        _NODISCARD bool any() const noexcept { return find_first() != npos; }
+
+        _NODISCARD bool none() const noexcept { return !any(); }
+
+        _NODISCARD bool all() const noexcept { return count() == _self().size(); }
+
+        /**
+        * @return npos if no bit is set
+        */
+        _NODISCARD size_type find_first() const noexcept { return bits::find_next(data(), word_count(), 0); }
+
+        _NODISCARD size_type find_next(size_type const pos) const noexcept { return bits::find_next(data(), word_count(), pos); }
+
+        /**
+        * the indices of the set bits in increasing order
+        */
+        _NODISCARD set_bit_range set_bits() const noexcept { return { { data(), word_count(), 0 } }; }
+
+        /**
+        * @param [] other - of the same size
+        */
+        Derived& operator&=(Derived const& other) noexcept {
+            bits::assign_and(data(), other.data(), word_count());
+            return _self();
+        }
+
+        Derived& operator|=(Derived const& other) noexcept {
+            bits::assign_or(data(), other.data(), word_count());
+            return _self();
+        }
+
+        Derived& operator^=(Derived const& other) noexcept {
+            bits::assign_xor(data(), other.data(), word_count());
+            return _self();
+        }
+
+        _NODISCARD friend Derived operator&(Derived l, Derived const& r) noexcept(std::is_nothrow_copy_constructible<Derived>::value) { return static_cast<Derived&&>(l &= r); }
+
+        _NODISCARD friend Derived operator|(Derived l, Derived const& r) noexcept(std::is_nothrow_copy_constructible<Derived>::value) { return static_cast<Derived&&>(l |= r); }
+
+        _NODISCARD friend Derived operator^(Derived l, Derived const& r) noexcept(std::is_nothrow_copy_constructible<Derived>::value) { return static_cast<Derived&&>(l ^= r); }
+
+        _NODISCARD Derived operator~() const {
+            Derived res = _self();
+            return static_cast<Derived&&>(res.flip());
+        }
+
+        _NODISCARD friend bool operator==(Derived const& l, Derived const& r) noexcept {
+            return l.size() == r.size() && bits::equal(l.data(), r.data(), l.word_count());
+        }
+
+        _NODISCARD friend bool operator!=(Derived const& l, Derived const& r) noexcept { return !(l == r); }
+
+        template<class Proc, class... Args>
+        type_if<size_type, util::invocable_v<Proc, bool, Args...>> foreach(Proc&& proc, Args&&... args) const {
+            size_t const n = _self().size();
+            word const* const w = data();
+            for (size_t i = 0; i != n; ++i) util::invoke(proc, bool((w[i / word_bits] >> (i % word_bits)) & 1), args...);
+            return n;
+        }
+
+        template<class Proc, class... Args>
+        type_if<size_type, util::invocable_v<Proc, bool, Args...>> rforeach(Proc&& proc, Args&&... args) const {
+            size_t const n = _self().size();
+            word const* const w = data();
+            for (size_t i = n; i != 0; ) {
+                --i;
+                util::invoke(proc, bool((w[i / word_bits] >> (i % word_bits)) & 1), args...);
+            }
+            return n;
+        }
+
+    protected:
+        _NODISCARD Derived& _self() noexcept { return static_cast<Derived&>(*this); }
+
+        _NODISCARD Derived const& _self() const noexcept { return static_cast<Derived const&>(*this); }
+
+        Derived& _trim() noexcept {
+            size_t const n = word_count();
+            if (n) data()[n - 1] &= tail_mask(_self().size());
+            return _self();
+        }
+
+        void _check(size_type const pos) const {
+            if (pos >= _self().size())
+                std::_Xout_of_range("bit_array::at");
+        }
+    };
+
+    template<size_t...> friend struct bit_array;
+};
+
+/**
+* N bits packed into words
+*/
+template<size_t N> struct bit_array<N> : bits::_ops<bit_array<N>> {
+    constexpr bit_array() noexcept : m_words{} {}
+
+    /**
+    * @param [] value - the first min(N, 64) bits
+    */
+    constexpr explicit bit_array(uint64_t const value) noexcept : m_words{} {
+        m_words[0] = N < bits::word_bits ? value & bits::tail_mask(N) : value;
+    }
+
+    _NODISCARD constexpr static size_t size() noexcept { return N; }
+
+    _NODISCARD constexpr static bool empty() noexcept { return N == 0; }
+
+protected:
+    array<bits::word, N ? bits::words(N) : 1> m_words;
+
+    _NODISCARD bits::word* _words() noexcept { return m_words.data(); }
+
+    _NODISCARD bits::word const* _words() const noexcept { return m_words.data(); }
+
+    friend struct bits::_ops<bit_array<N>>;
+};
+
+/**
+* a runtime count of bits packed into words
+*/
+template<> struct bit_array<> : bits::_ops<bit_array<>> {
+    bit_array() noexcept : m_words(), m_size(0) {}
+
+    /**
+    * @param [] value - every bit
+    */
+    explicit bit_array(size_t const n, bool const value = false) : m_words(bits::words(n)), m_size(n) {
+        if (value) fill(true);
+    }
+
+    bit_array(bit_array const& other) : m_words(other.m_words), m_size(other.m_size) {}
+
+    bit_array(bit_array&& other) noexcept : m_words(static_cast<array<bits::word>&&>(other.m_words)), m_size(other.m_size) {
+        other.m_size = 0;
+    }
+
+    bit_array& operator=(bit_array other) noexcept {
+        swap(other);
+        return *this;
+    }
+
+    void swap(bit_array& other) noexcept {
+        m_words.swap(other.m_words);
+        std::swap(m_size, other.m_size);
+    }
+
+    _NODISCARD size_t size() const noexcept { return m_size; }
+
+    _NODISCARD bool empty() const noexcept { return m_size == 0; }
+
+protected:
+    array<bits::word> m_words;
+    size_t m_size;
+
+    _NODISCARD bits::word* _words() noexcept { return m_words.data(); }
+
+    _NODISCARD bits::word const* _words() const noexcept { return m_words.data(); }
+
+    friend struct bits::_ops<bit_array<>>;
+};
+
+#endif // !__BIT_ARRAY_HPP
@@ -64,6 +64,8 @@ struct comporator : protected object<EqualTo>, protected object<Less> {
 		return static_cast<Less const&>(*this)(static_cast<L&&>(l), static_cast<R&&>(r)) ? -1 : 1;
 	}
 
+	constexpr Less const& less_than() const noexcept { return static_cast<Less const&>(*this); }
+
 	using is_transparent = int;
 };
 
@@ -107,6 +109,8 @@ struct comporator<void, Less> : protected object<Less> {
 		return 0;
 	}
 
+	constexpr Less const& less_than() const noexcept { return static_cast<Less const&>(*this); }
+
 	using is_transparent = int;
 };
 
@@ -0,0 +1,279 @@
+#ifndef __CONCURRENT_QUEUE_HPP
+#define __CONCURRENT_QUEUE_HPP 1
+
+#include "util.hpp"
+#include "object.hpp"
+#include "array.hpp"
+#include <atomic>
+#include <cstring>
+#include <type_traits>
+
+/**
+* bounded single-producer single-consumer queue over an array<T, N>: wait-free, each side owns one index
+* and caches the other's, so the shared cache lines are touched only when the cached view runs out
+* @param [] N - the capacity, a power of two
+*/
+template<class T, size_t N> struct spsc_queue {
+    static_assert(N != 0 && (N & (N - 1)) == 0, "N is not a power of two");
+
+    using value_type = T;
+    using size_type = size_t;
+
+    spsc_queue() noexcept(is_nothrow_constructible_v<T>) : m_tail(0), m_head_cache(0), m_head(0), m_tail_cache(0), m_elems() {}
+
+    spsc_queue(spsc_queue const&) = delete;
+    spsc_queue& operator=(spsc_queue const&) = delete;
+
+    _NODISCARD constexpr static size_type capacity() noexcept { return N; }
+
+    /**
+    * exact only when neither side is running
+    */
+    _NODISCARD size_type size_approx() const noexcept {
+        return m_tail.load(std::memory_order_acquire) - m_head.load(std::memory_order_acquire);
+    }
+
+    /**
+    * producer side
+    * @return false if full
+    */
+    template<class V, type_if<int, is_assignable_v<T&, V&&>> = 0>
+    bool try_push(V&& value) noexcept(std::is_nothrow_assignable<T&, V&&>::value) {
+        size_t const tail = m_tail.load(std::memory_order_relaxed);
+        if (tail - m_head_cache == N) {
+            m_head_cache = m_head.load(std::memory_order_acquire);
+            if (tail - m_head_cache == N) return false;
+        }
+        m_elems[tail & _mask] = static_cast<V&&>(value);
+        m_tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+    * producer side: pushes as many of the n elements as fit, published at once
+    * @return the count pushed
+    */
+    size_type try_push_n(T const* const data, size_type const n) noexcept(std::is_nothrow_copy_assignable<T>::value) {
+        size_t const tail = m_tail.load(std::memory_order_relaxed);
+        if (N - (tail - m_head_cache) < n) m_head_cache = m_head.load(std::memory_order_acquire);
+        size_t const free = N - (tail - m_head_cache);
+        size_t const count = n < free ? n : free;
+        if (!count) return 0;
+        size_t const pos = tail & _mask;
+        size_t const first = count < N - pos ? count : N - pos;
+        _copy(m_elems.data() + pos, data, first, std::is_trivially_copyable<T>{});
+        _copy(m_elems.data(), data + first, count - first, std::is_trivially_copyable<T>{});
+        m_tail.store(tail + count, std::memory_order_release);
+        return count;
+    }
+
+    /**
+    * consumer side
+    * @return false if empty
+    */
+    bool try_pop(T& out) noexcept(std::is_nothrow_move_assignable<T>::value) {
+        size_t const head = m_head.load(std::memory_order_relaxed);
+        if (head == m_tail_cache) {
+            m_tail_cache = m_tail.load(std::memory_order_acquire);
+            if (head == m_tail_cache) return false;
+        }
+        out = static_cast<T&&>(m_elems[head & _mask]);
+        m_head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+    * consumer side: pops up to n elements, released at once
+    * @return the count popped
+    */
+    size_type try_pop_n(T* const out, size_type const n) noexcept(std::is_nothrow_move_assignable<T>::value) {
+        size_t const head = m_head.load(std::memory_order_relaxed);
+        if (m_tail_cache - head < n) m_tail_cache = m_tail.load(std::memory_order_acquire);
+        size_t const ready = m_tail_cache - head;
+        size_t const count = n < ready ? n : ready;
+        if (!count) return 0;
+        size_t const pos = head & _mask;
+        size_t const first = count < N - pos ? count : N - pos;
+        _move(out, m_elems.data() + pos, first, std::is_trivially_copyable<T>{});
+        _move(out + first, m_elems.data(), count - first, std::is_trivially_copyable<T>{});
+        m_head.store(head + count, std::memory_order_release);
+        return count;
+    }
+
+protected:
+    constexpr _INLINE_VAR static size_t _mask = N - 1;
+    constexpr _INLINE_VAR static size_t _line = 64;
+
+    /**
+    * written by the producer
+    */
+    alignas(_line) std::atomic<size_t> m_tail;
+    size_t m_head_cache;
+
+    /**
+    * written by the consumer
+    */
+    alignas(_line) std::atomic<size_t> m_head;
+    size_t m_tail_cache;
+
+    alignas(_line) array<T, N> m_elems;
+
+    static void _copy(T* const dst, T const* const src, size_t const n, true_type) noexcept {
+        if (n) std::memcpy(dst, src, n * sizeof(T));
+    }
+
+    static void _copy(T* const dst, T const* const src, size_t const n, false_type) noexcept(std::is_nothrow_copy_assignable<T>::value) {
+        for (size_t i = 0; i != n; ++i) dst[i] = src[i];
+    }
+
+    static void _move(T* const dst, T* const src, size_t const n, true_type) noexcept {
+        if (n) std::memcpy(dst, src, n * sizeof(T));
+    }
+
+    static void _move(T* const dst, T* const src, size_t const n, false_type) noexcept(std::is_nothrow_move_assignable<T>::value) {
+        for (size_t i = 0; i != n; ++i) dst[i] = static_cast<T&&>(src[i]);
+    }
+};
+
+/**
+* bounded multi-producer multi-consumer queue over an array<T, N> of slots, each with a sequence number telling
+* which turn of which side it awaits (after D. Vyukov): lock-free, a push or a pop is one CAS on a shared index
+* @param [] N - the capacity, a power of two
+*/
+template<class T, size_t N> struct mpmc_queue {
+    static_assert(N != 0 && (N & (N - 1)) == 0, "N is not a power of two");
+
+    using value_type = T;
+    using size_type = size_t;
+
+    mpmc_queue() noexcept(is_nothrow_constructible_v<T>) : m_tail(0), m_head(0), m_slots() {
+        for (size_t i = 0; i != N; ++i) m_slots[i].seq.store(i, std::memory_order_relaxed);
+    }
+
+    mpmc_queue(mpmc_queue const&) = delete;
+    mpmc_queue& operator=(mpmc_queue const&) = delete;
+
+    _NODISCARD constexpr static size_type capacity() noexcept { return N; }
+
+    _NODISCARD size_type size_approx() const noexcept {
+        size_t const tail = m_tail.load(std::memory_order_acquire);
+        size_t const head = m_head.load(std::memory_order_acquire);
+        return tail > head ? tail - head : 0;
+    }
+
+    /**
+    * @return false if full
+    */
+    template<class V, type_if<int, is_assignable_v<T&, V&&>> = 0>
+    bool try_push(V&& value) noexcept(std::is_nothrow_assignable<T&, V&&>::value) {
+        size_t pos = m_tail.load(std::memory_order_relaxed);
+        for (;;) {
+            ptrdiff_t const diff = ptrdiff_t(m_slots[pos & _mask].seq.load(std::memory_order_acquire) - pos);
+            if (diff == 0) {
+                if (m_tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+            }
+            else if (diff < 0) return false;
+            else pos = m_tail.load(std::memory_order_relaxed);
+        }
+        _slot& slot = m_slots[pos & _mask];
+        slot.value = static_cast<V&&>(value);
+        slot.seq.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+    * claims a run of free slots with a single CAS
+    * @return the count pushed, less than n if the queue fills up
+    */
+    size_type try_push_n(T const* const data, size_type const n) noexcept(std::is_nothrow_copy_assignable<T>::value) {
+        if (!n) return 0;
+        size_t pos = m_tail.load(std::memory_order_relaxed);
+        size_t count;
+        for (;;) {
+            count = _run(pos, n, 0);
+            if (!count) {
+                if (ptrdiff_t(m_slots[pos & _mask].seq.load(std::memory_order_acquire) - pos) < 0) return 0;
+                pos = m_tail.load(std::memory_order_relaxed);
+            }
+            else if (m_tail.compare_exchange_weak(pos, pos + count, std::memory_order_relaxed)) break;
+        }
+        for (size_t i = 0; i != count; ++i) {
+            _slot& slot = m_slots[(pos + i) & _mask];
+            slot.value = data[i];
+            slot.seq.store(pos + i + 1, std::memory_order_release);
+        }
+        return count;
+    }
+
+    /**
+    * @return false if empty
+    */
+    bool try_pop(T& out) noexcept(std::is_nothrow_move_assignable<T>::value) {
+        size_t pos = m_head.load(std::memory_order_relaxed);
+        for (;;) {
+            ptrdiff_t const diff = ptrdiff_t(m_slots[pos & _mask].seq.load(std::memory_order_acquire) - (pos + 1));
+            if (diff == 0) {
+                if (m_head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+            }
+            else if (diff < 0) return false;
+            else pos = m_head.load(std::memory_order_relaxed);
+        }
+        _slot& slot = m_slots[pos & _mask];
+        out = static_cast<T&&>(slot.value);
+        slot.seq.store(pos + N, std::memory_order_release);
+        return true;
+    }
+
+    /**
+    * claims a run of filled slots with a single CAS
+    * @return the count popped
+    */
+    size_type try_pop_n(T* const out, size_type const n) noexcept(std::is_nothrow_move_assignable<T>::value) {
+        if (!n) return 0;
+        size_t pos = m_head.load(std::memory_order_relaxed);
+        size_t count;
+        for (;;) {
+            count = _run(pos, n, 1);
+            if (!count) {
+                if (ptrdiff_t(m_slots[pos & _mask].seq.load(std::memory_order_acquire) - (pos + 1)) < 0) return 0;
+                pos = m_head.load(std::memory_order_relaxed);
+            }
+            else if (m_head.compare_exchange_weak(pos, pos + count, std::memory_order_relaxed)) break;
+        }
+        for (size_t i = 0; i != count; ++i) {
+            _slot& slot = m_slots[(pos + i) & _mask];
+            out[i] = static_cast<T&&>(slot.value);
+            slot.seq.store(pos + i + N, std::memory_order_release);
+        }
+        return count;
+    }
+
+protected:
+    constexpr _INLINE_VAR static size_t _mask = N - 1;
+    constexpr _INLINE_VAR static size_t _line = 64;
+
+    struct _slot {
+        std::atomic<size_t> seq;
+        T value;
+
+        _slot() noexcept(is_nothrow_constructible_v<T>) : seq(0), value() {}
+    };
+
+    alignas(_line) std::atomic<size_t> m_tail;
+    alignas(_line) std::atomic<size_t> m_head;
+    alignas(_line) array<_slot, N> m_slots;
+
+    /**
+    * the count of consecutive slots from pos, at most n, awaiting their turn: seq == pos + i + turn.
+    * No other thread can claim them before the CAS from pos succeeds
+    */
+    _NODISCARD size_t _run(size_t const pos, size_t const n, size_t const turn) const noexcept {
+        size_t i = 0;
+        for (size_t const max = n < N ? n : N; i != max; ++i) {
+            if (m_slots[(pos + i) & _mask].seq.load(std::memory_order_acquire) != pos + i + turn) break;
+        }
+        return i;
+    }
+};
+
+#endif // !__CONCURRENT_QUEUE_HPP
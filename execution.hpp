@@ -0,0 +1,113 @@
+#ifndef __EXECUTION_HPP
+#define __EXECUTION_HPP 1
+
+#include "util.hpp"
+#include <memory>
+#include <thread>
+#include <algorithm>
+
+#if _HAS_CXX17
+#include <execution>
+#endif // _HAS_CXX17
+
+struct execution {
+#if _HAS_CXX17
+    using sequenced_policy = std::execution::sequenced_policy;
+    using parallel_policy = std::execution::parallel_policy;
+    using parallel_unsequenced_policy = std::execution::parallel_unsequenced_policy;
+
+    constexpr _INLINE_VAR static sequenced_policy const& seq = std::execution::seq;
+    constexpr _INLINE_VAR static parallel_policy const& par = std::execution::par;
+    constexpr _INLINE_VAR static parallel_unsequenced_policy const& par_unseq = std::execution::par_unseq;
+
+    template<class Policy> constexpr _INLINE_VAR static bool is_policy_v = std::is_execution_policy<remove_cvref_t<Policy>>::value;
+
+    template<class Policy> constexpr _INLINE_VAR static bool is_parallel_v = is_policy_v<Policy> && !is_same_v<remove_cvref_t<Policy>, sequenced_policy>;
+#else
+    struct sequenced_policy {};
+
+    constexpr _INLINE_VAR static sequenced_policy seq{};
+
+    template<class Policy> constexpr _INLINE_VAR static bool is_policy_v = is_same_v<remove_cvref_t<Policy>, sequenced_policy>;
+
+    template<class Policy> constexpr _INLINE_VAR static bool is_parallel_v = false;
+#endif // _HAS_CXX17
+
+    template<class Policy> struct is_policy : conditional<is_policy_v<Policy>> {};
+
+    /**
+    * the minimal count of elements worth a separate chunk
+    */
+    constexpr _INLINE_VAR static size_t grain = size_t(1) << 14;
+
+    _NODISCARD static size_t chunks(size_t const n) noexcept {
+        size_t const threads = std::thread::hardware_concurrency();
+        size_t const max = (threads ? threads : 1) * 4;
+        size_t const by_grain = n / grain;
+        return by_grain < max ? (by_grain ? by_grain : 1) : max;
+    }
+
+    /**
+    * @param [] work - the cost of each of the n items, in elements
+    * @return at most n chunks
+    */
+    _NODISCARD static size_t chunks(size_t const n, size_t const work) noexcept {
+        size_t const count = chunks(work >= grain ? n * grain : n * work);
+        return count < n ? count : (n ? n : 1);
+    }
+
+    /**
+    * @param [] policy
+    * @param [] count
+    * @param [ref] f - invoked as f(i) for each i in [0, count)
+    */
+    template<class Policy, class F>
+    static type_if<void, is_policy_v<Policy>, util::invocable_v<F&, size_t>> for_n(Policy&& policy, size_t const count, F&& f) {
+        if (!is_parallel_v<Policy> || count < 2) {
+            for (size_t i = 0; i != count; ++i) util::invoke(f, i);
+            return;
+        }
+#if _HAS_CXX17
+        std::unique_ptr<size_t[]> const ids(new size_t[count]);
+        for (size_t i = 0; i != count; ++i) ids[i] = i;
+        std::for_each(static_cast<Policy&&>(policy), ids.get(), ids.get() + count, [&f](size_t const i) {
+            util::invoke(f, i);
+        });
+#endif // _HAS_CXX17
+    }
+
+    /**
+    * @param [] policy
+    * @param [] n - the length of the range
+    * @param [ref] chunk - invoked as chunk(first, last) for disjoint subranges covering [0, n)
+    */
+    template<class Policy, class Chunk>
+    static type_if<void, is_policy_v<Policy>, util::invocable_v<Chunk&, size_t, size_t>> for_chunks(Policy&& policy, size_t const n, Chunk&& chunk) {
+        size_t const count = is_parallel_v<Policy> ? chunks(n) : 1;
+        if (count < 2) {
+            if (n) util::invoke(chunk, size_t(0), n);
+            return;
+        }
+        for_n(static_cast<Policy&&>(policy), count, [n, count, &chunk](size_t const i) {
+            util::invoke(chunk, n * i / count, n * (i + 1) / count);
+        });
+    }
+
+    /**
+    * as for_chunks(policy, n, chunk), with the chunks sized by the total work rather than by the count of items
+    * @param [] work - the cost of each item, in elements
+    */
+    template<class Policy, class Chunk>
+    static type_if<void, is_policy_v<Policy>, util::invocable_v<Chunk&, size_t, size_t>> for_chunks(Policy&& policy, size_t const n, size_t const work, Chunk&& chunk) {
+        size_t const count = is_parallel_v<Policy> ? chunks(n, work) : 1;
+        if (count < 2) {
+            if (n) util::invoke(chunk, size_t(0), n);
+            return;
+        }
+        for_n(static_cast<Policy&&>(policy), count, [n, count, &chunk](size_t const i) {
+            util::invoke(chunk, n * i / count, n * (i + 1) / count);
+        });
+    }
+};
+
+#endif // !__EXECUTION_HPP
@@ -0,0 +1,382 @@
+#ifndef __FLAT_MAP_HPP
+#define __FLAT_MAP_HPP 1
+
+#include "util.hpp"
+#include "object.hpp"
+#include "comporator.hpp"
+#include "pair.hpp"
+#include "array.hpp"
+#include "algorithm.hpp"
+
+template<class...> struct flat_table;
+
+using flat_tables = flat_table<>;
+
+/**
+* the sorting and merging shared by flat_map and flat_set
+*/
+template<> struct flat_table<> {
+    constexpr _INLINE_VAR static size_t npos = size_t(-1);
+
+protected:
+    /**
+    * orders pairs by their first
+    */
+    template<class Comp> struct _by_first {
+        Comp const& comp;
+
+        template<class L, class R> constexpr auto operator()(L const& l, R const& r) const -> decltype(util::invoke(comp, l.first, r.first)) {
+            return util::invoke(comp, l.first, r.first);
+        }
+    };
+
+    template<class Comp> struct _by_self {
+        Comp const& comp;
+
+        template<class L, class R> constexpr auto operator()(L const& l, R const& r) const -> decltype(util::invoke(comp, l, r)) {
+            return util::invoke(comp, l, r);
+        }
+    };
+
+    template<class K> _NODISCARD static K const& _key(K const& key) noexcept { return key; }
+
+    template<class K, class V> _NODISCARD static K const& _key(pair<K, V> const& item) noexcept { return item.first; }
+
+    /**
+    * stable sort, then keeps the first of each run of equal keys
+    * @return the count kept, at the front
+    */
+    template<class T, class Comp> static size_t _sort_unique(T* const data, size_t const n, Comp const& comp) {
+        if (n == 0) return 0;
+        algorithms::stable_sort(data, data + n, comp);
+        size_t kept = 1;
+        for (size_t i = 1; i != n; ++i) {
+            if (comp(data[kept - 1], data[i]) < 0) {
+                if (kept != i) data[kept] = static_cast<T&&>(data[i]);
+                ++kept;
+            }
+        }
+        return kept;
+    }
+
+    /**
+    * the size of the union of two sorted runs of unique keys
+    */
+    template<class K, class T, class Comp> _NODISCARD static size_t _union_size(K const* a, size_t const na, T const* b, size_t const nb, Comp const& comp) {
+        size_t i = 0, j = 0, res = 0;
+        while (i != na && j != nb) {
+            auto const order = util::invoke(comp, a[i], _key(b[j]));
+            i += !(order > 0);
+            j += !(order < 0);
+            ++res;
+        }
+        return res + (na - i) + (nb - j);
+    }
+};
+
+/**
+* sorted map over two contiguous arrays, keys and values apart so that a search touches keys only;
+* lookups are branchless binary searches, inserting one element is O(n) and a batch is sorted and merged in one pass
+*/
+template<class K, class V, class Comparator = default_comporator> struct flat_map : flat_table<>, protected object<Comparator> {
+    using key_type = K;
+    using mapped_type = V;
+    using value_type = pair<K, V>;
+    using size_type = size_t;
+    using comporator_t = object<Comparator>;
+
+    flat_map() noexcept(is_nothrow_constructible_v<comporator_t>) : comporator_t(), m_keys(), m_values() {}
+
+    explicit flat_map(Comparator const& cmp) : comporator_t(cmp), m_keys(), m_values() {}
+
+    /**
+    * sorts once; of equal keys the first is kept
+    */
+    explicit flat_map(array<value_type>&& items, Comparator const& cmp = Comparator()) : comporator_t(cmp), m_keys(), m_values() {
+        size_t const n = _sort_unique(items.data(), items.size(), _by_first<Comparator>{ _comp() });
+        array<K> keys{ arrays::for_overwrite, n };
+        array<V> values{ arrays::for_overwrite, n };
+        for (size_t i = 0; i != n; ++i) {
+            keys.data()[i] = static_cast<K&&>(items.data()[i].first);
+            values.data()[i] = static_cast<V&&>(items.data()[i].second);
+        }
+        m_keys.swap(keys);
+        m_values.swap(values);
+    }
+
+    _NODISCARD size_type size() const noexcept { return m_keys.size(); }
+
+    _NODISCARD bool empty() const noexcept { return m_keys.size() == 0; }
+
+    /**
+    * sorted
+    */
+    _NODISCARD array<K> const& keys() const noexcept { return m_keys; }
+
+    /**
+    * in the order of the keys
+    */
+    _NODISCARD array<V>& values() noexcept { return m_values; }
+
+    _NODISCARD array<V> const& values() const noexcept { return m_values; }
+
+    /**
+    * @return the position of key, npos if absent
+    */
+    template<class U> _NODISCARD type_if<size_t, objects::is_ordering_v<util::invoke_result_t<Comparator const&, K const&, U const&>>> index_of(U const& key) const {
+        size_t const i = algorithms::lower_bound(m_keys.data(), m_keys.data() + size(), key, _comp());
+        return i != size() && !(util::invoke(_comp(), key, m_keys.data()[i]) < 0) ? i : npos;
+    }
+
+    /**
+    * @return nullptr if absent
+    */
+    template<class U> _NODISCARD V* find(U const& key) {
+        size_t const i = index_of(key);
+        return i == npos ? nullptr : m_values.data() + i;
+    }
+
+    template<class U> _NODISCARD V const* find(U const& key) const {
+        size_t const i = index_of(key);
+        return i == npos ? nullptr : m_values.data() + i;
+    }
+
+    template<class U> _NODISCARD bool contains(U const& key) const { return index_of(key) != npos; }
+
+    template<class U> _NODISCARD size_type count(U const& key) const { return contains(key); }
+
+    template<class U> _NODISCARD V& at(U const& key) {
+        V* const value = find(key);
+        if (!value)
+            std::_Xout_of_range("flat_map::at");
+        return *value;
+    }
+
+    template<class U> _NODISCARD V const& at(U const& key) const {
+        V const* const value = find(key);
+        if (!value)
+            std::_Xout_of_range("flat_map::at");
+        return *value;
+    }
+
+    /**
+    * O(n): the arrays are rebuilt
+    * @return false if the key is present, which keeps its value
+    */
+    template<class Key, class Value, type_if<int, is_constructible_v<K, Key&&>, is_constructible_v<V, Value&&>> = 0>
+    bool insert(Key&& key, Value&& value) {
+        size_t const i = algorithms::lower_bound(m_keys.data(), m_keys.data() + size(), key, _comp());
+        if (i != size() && !(util::invoke(_comp(), key, m_keys.data()[i]) < 0)) return false;
+        size_t const n = size();
+        array<K> keys{ arrays::for_overwrite, n + 1 };
+        array<V> values{ arrays::for_overwrite, n + 1 };
+        _move(m_keys.data(), keys.data(), 0, i);
+        _move(m_values.data(), values.data(), 0, i);
+        keys.data()[i] = K(static_cast<Key&&>(key));
+        values.data()[i] = V(static_cast<Value&&>(value));
+        _move(m_keys.data() + i, keys.data() + i + 1, 0, n - i);
+        _move(m_values.data() + i, values.data() + i + 1, 0, n - i);
+        m_keys.swap(keys);
+        m_values.swap(values);
+        return true;
+    }
+
+    /**
+    * sorts the batch and merges it in a single pass; keys already present keep their values
+    * @return the count inserted
+    */
+    size_type insert(array<value_type>&& items) {
+        _by_first<Comparator> const by_first{ _comp() };
+        size_t const nb = _sort_unique(items.data(), items.size(), by_first);
+        size_t const na = size();
+        size_t const n = _union_size(m_keys.data(), na, items.data(), nb, _comp());
+        if (n == na) return 0;
+        array<K> keys{ arrays::for_overwrite, n };
+        array<V> values{ arrays::for_overwrite, n };
+        K* const ka = m_keys.data();
+        V* const va = m_values.data();
+        value_type* const b = items.data();
+        size_t i = 0, j = 0, k = 0;
+        for (; i != na && j != nb; ++k) {
+            auto const order = util::invoke(_comp(), ka[i], b[j].first);
+            if (order > 0) {
+                keys.data()[k] = static_cast<K&&>(b[j].first);
+                values.data()[k] = static_cast<V&&>(b[j].second);
+                ++j;
+                continue;
+            }
+            keys.data()[k] = static_cast<K&&>(ka[i]);
+            values.data()[k] = static_cast<V&&>(va[i]);
+            j += !(order < 0);
+            ++i;
+        }
+        for (; i != na; ++i, ++k) {
+            keys.data()[k] = static_cast<K&&>(ka[i]);
+            values.data()[k] = static_cast<V&&>(va[i]);
+        }
+        for (; j != nb; ++j, ++k) {
+            keys.data()[k] = static_cast<K&&>(b[j].first);
+            values.data()[k] = static_cast<V&&>(b[j].second);
+        }
+        m_keys.swap(keys);
+        m_values.swap(values);
+        return n - na;
+    }
+
+    /**
+    * O(n): the arrays are rebuilt
+    * @return the count erased
+    */
+    template<class U> size_type erase(U const& key) {
+        size_t const i = index_of(key);
+        if (i == npos) return 0;
+        size_t const n = size();
+        array<K> keys{ arrays::for_overwrite, n - 1 };
+        array<V> values{ arrays::for_overwrite, n - 1 };
+        _move(m_keys.data(), keys.data(), 0, i);
+        _move(m_values.data(), values.data(), 0, i);
+        _move(m_keys.data() + i + 1, keys.data() + i, 0, n - i - 1);
+        _move(m_values.data() + i + 1, values.data() + i, 0, n - i - 1);
+        m_keys.swap(keys);
+        m_values.swap(values);
+        return 1;
+    }
+
+    /**
+    * visits the entries in key order
+    * @param [] proc - invoked as proc(key, value)
+    */
+    template<class Proc>
+    type_if<size_type, util::invocable_v<Proc&, K const&, V&>> foreach(Proc&& proc) {
+        for (size_t i = 0; i != size(); ++i) util::invoke(proc, m_keys.data()[i], m_values.data()[i]);
+        return size();
+    }
+
+    template<class Proc>
+    type_if<size_type, util::invocable_v<Proc&, K const&, V const&>> foreach(Proc&& proc) const {
+        for (size_t i = 0; i != size(); ++i) util::invoke(proc, m_keys.data()[i], static_cast<V const&>(m_values.data()[i]));
+        return size();
+    }
+
+protected:
+    array<K> m_keys;
+    array<V> m_values;
+
+    _NODISCARD Comparator const& _comp() const noexcept { return static_cast<Comparator const&>(*this); }
+
+    template<class T> static void _move(T* const src, T* const dst, size_t const from, size_t const to) {
+        for (size_t i = from; i != to; ++i) dst[i] = static_cast<T&&>(src[i]);
+    }
+};
+
+/**
+* sorted set over a contiguous array, searched by branchless binary search
+*/
+template<class K, class Comparator = default_comporator> struct flat_set : flat_table<>, protected object<Comparator> {
+    using key_type = K;
+    using value_type = K;
+    using size_type = size_t;
+    using comporator_t = object<Comparator>;
+
+    flat_set() noexcept(is_nothrow_constructible_v<comporator_t>) : comporator_t(), m_keys() {}
+
+    explicit flat_set(Comparator const& cmp) : comporator_t(cmp), m_keys() {}
+
+    /**
+    * sorts once and drops the duplicates
+    */
+    explicit flat_set(array<K>&& keys, Comparator const& cmp = Comparator()) : comporator_t(cmp), m_keys() {
+        size_t const n = _sort_unique(keys.data(), keys.size(), _by_self<Comparator>{ _comp() });
+        if (n == keys.size()) m_keys.swap(keys);
+        else {
+            array<K> unique{ arrays::for_overwrite, n };
+            for (size_t i = 0; i != n; ++i) unique.data()[i] = static_cast<K&&>(keys.data()[i]);
+            m_keys.swap(unique);
+        }
+    }
+
+    _NODISCARD size_type size() const noexcept { return m_keys.size(); }
+
+    _NODISCARD bool empty() const noexcept { return m_keys.size() == 0; }
+
+    /**
+    * sorted
+    */
+    _NODISCARD array<K> const& keys() const noexcept { return m_keys; }
+
+    template<class U> _NODISCARD type_if<size_t, objects::is_ordering_v<util::invoke_result_t<Comparator const&, K const&, U const&>>> index_of(U const& key) const {
+        size_t const i = algorithms::lower_bound(m_keys.data(), m_keys.data() + size(), key, _comp());
+        return i != size() && !(util::invoke(_comp(), key, m_keys.data()[i]) < 0) ? i : npos;
+    }
+
+    template<class U> _NODISCARD bool contains(U const& key) const { return index_of(key) != npos; }
+
+    template<class U> _NODISCARD size_type count(U const& key) const { return contains(key); }
+
+    /**
+    * O(n): the array is rebuilt
+    */
+    template<class Key, type_if<int, is_constructible_v<K, Key&&>> = 0>
+    bool insert(Key&& key) {
+        size_t const i = algorithms::lower_bound(m_keys.data(), m_keys.data() + size(), key, _comp());
+        if (i != size() && !(util::invoke(_comp(), key, m_keys.data()[i]) < 0)) return false;
+        size_t const n = size();
+        array<K> keys{ arrays::for_overwrite, n + 1 };
+        for (size_t j = 0; j != i; ++j) keys.data()[j] = static_cast<K&&>(m_keys.data()[j]);
+        keys.data()[i] = K(static_cast<Key&&>(key));
+        for (size_t j = i; j != n; ++j) keys.data()[j + 1] = static_cast<K&&>(m_keys.data()[j]);
+        m_keys.swap(keys);
+        return true;
+    }
+
+    /**
+    * sorts the batch and merges it in a single pass
+    * @return the count inserted
+    */
+    size_type insert(array<K>&& batch) {
+        size_t const nb = _sort_unique(batch.data(), batch.size(), _by_self<Comparator>{ _comp() });
+        size_t const na = size();
+        size_t const n = _union_size(m_keys.data(), na, batch.data(), nb, _comp());
+        if (n == na) return 0;
+        array<K> keys{ arrays::for_overwrite, n };
+        K* const a = m_keys.data();
+        K* const b = batch.data();
+        size_t i = 0, j = 0, k = 0;
+        for (; i != na && j != nb; ++k) {
+            auto const order = util::invoke(_comp(), a[i], b[j]);
+            if (order > 0) keys.data()[k] = static_cast<K&&>(b[j++]);
+            else {
+                keys.data()[k] = static_cast<K&&>(a[i++]);
+                j += !(order < 0);
+            }
+        }
+        for (; i != na; ++i, ++k) keys.data()[k] = static_cast<K&&>(a[i]);
+        for (; j != nb; ++j, ++k) keys.data()[k] = static_cast<K&&>(b[j]);
+        m_keys.swap(keys);
+        return n - na;
+    }
+
+    template<class U> size_type erase(U const& key) {
+        size_t const i = index_of(key);
+        if (i == npos) return 0;
+        size_t const n = size();
+        array<K> keys{ arrays::for_overwrite, n - 1 };
+        for (size_t j = 0; j != i; ++j) keys.data()[j] = static_cast<K&&>(m_keys.data()[j]);
+        for (size_t j = i + 1; j != n; ++j) keys.data()[j - 1] = static_cast<K&&>(m_keys.data()[j]);
+        m_keys.swap(keys);
+        return 1;
+    }
+
+    template<class Proc, class... Args>
+    type_if<size_type, util::invocable_v<Proc, K const&, Args...>> foreach(Proc&& proc, Args&&... args) const {
+        for (size_t i = 0; i != size(); ++i) util::invoke(proc, m_keys.data()[i], args...);
+        return size();
+    }
+
+protected:
+    array<K> m_keys;
+
+    _NODISCARD Comparator const& _comp() const noexcept { return static_cast<Comparator const&>(*this); }
+};
+
+#endif // !__FLAT_MAP_HPP
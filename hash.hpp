@@ -0,0 +1,271 @@
+#ifndef __HASH_HPP
+#define __HASH_HPP 1
+
+#include "util.hpp"
+#include "object.hpp"
+#include "pair.hpp"
+#include "optional.hpp"
+#include "array.hpp"
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <type_traits>
+
+#if defined(_MSC_VER) && defined(_M_X64)
+#include <intrin.h>
+#endif
+
+#if defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2) || defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+/**
+* seedable hash of library types: contiguous elements without padding are hashed as bytes in one pass,
+* composites combine the hashes of their parts, anything else goes through std::hash
+*/
+struct hasher {
+    uint64_t seed;
+
+    constexpr hasher() noexcept : seed(0) {}
+
+    constexpr explicit hasher(uint64_t const seed) noexcept : seed(seed) {}
+
+    template<class T> _NODISCARD size_t operator()(T const& value) const noexcept(noexcept(_hash(value, uint64_t()))) {
+        return size_t(_hash(value, seed));
+    }
+
+    /**
+    * wyhash over n bytes; inputs of at least bulk_threshold bytes take a striped path over eight 64-bit lanes, two to an SSE2 register
+    */
+    _NODISCARD static uint64_t bytes(void const* const data, size_t const n, uint64_t const seed = 0) noexcept {
+        auto const p = static_cast<unsigned char const*>(data);
+        return n < bulk_threshold ? _short(p, n, seed) : _bulk(p, n, seed);
+    }
+
+    /**
+    * order dependent: combine(combine(s, a), b) != combine(combine(s, b), a)
+    */
+    _NODISCARD static uint64_t combine(uint64_t const seed, uint64_t const hash) noexcept {
+        return _mix(seed ^ _secret[0], hash ^ _secret[1]);
+    }
+
+    constexpr _INLINE_VAR static size_t bulk_threshold = 256;
+
+protected:
+    constexpr _INLINE_VAR static uint64_t _secret[4] = {
+        0xa0761d6478bd642full, 0xe7037ed1a0b428dbull, 0x8ebc6af09c88c6e3ull, 0x589965cc75374cc3ull
+    };
+
+    /**
+    * integers, enumerations and pointers: equal values have equal bytes and there is no padding
+    */
+    template<class T> struct _bytewise : conditional<std::is_integral<T>::value || std::is_enum<T>::value || std::is_pointer<T>::value> {};
+
+    template<class T, size_t N> struct _bytewise<array<T, N>> : conditional<N != 0 && _bytewise<T>::value && sizeof(array<T, N>) == sizeof(T) * N> {};
+
+    template<class T, size_t N, size_t M, size_t... K> struct _bytewise<array<T, N, M, K...>> : _bytewise<array<array<T, M, K...>, N>> {};
+
+    /**
+    * the 128 bit product folded to 64 bits
+    */
+    _NODISCARD static uint64_t _mix(uint64_t const a, uint64_t const b) noexcept {
+#if defined(__SIZEOF_INT128__)
+        unsigned __int128 const r = (unsigned __int128)a * b;
+        return uint64_t(r) ^ uint64_t(r >> 64);
+#elif defined(_MSC_VER) && defined(_M_X64)
+        uint64_t hi;
+        uint64_t const lo = _umul128(a, b, &hi);
+        return lo ^ hi;
+#else
+        uint64_t const ha = a >> 32, hb = b >> 32, la = uint32_t(a), lb = uint32_t(b);
+        uint64_t const rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+        uint64_t const t = rl + (rm0 << 32);
+        uint64_t const lo = t + (rm1 << 32);
+        uint64_t const hi = rh + (rm0 >> 32) + (rm1 >> 32) + (t < rl) + (lo < t);
+        return lo ^ hi;
+#endif
+    }
+
+    _NODISCARD static uint64_t _r8(unsigned char const* const p) noexcept {
+        uint64_t v;
+        std::memcpy(&v, p, sizeof v);
+        return v;
+    }
+
+    _NODISCARD static uint64_t _r4(unsigned char const* const p) noexcept {
+        uint32_t v;
+        std::memcpy(&v, p, sizeof v);
+        return v;
+    }
+
+    _NODISCARD static uint64_t _short(unsigned char const* p, size_t const n, uint64_t seed) noexcept {
+        seed ^= _mix(seed ^ _secret[0], _secret[1]);
+        uint64_t a, b;
+        if (n <= 16) {
+            if (n >= 4) {
+                size_t const k = (n >> 3) << 2;
+                a = (_r4(p) << 32) | _r4(p + k);
+                b = (_r4(p + n - 4) << 32) | _r4(p + n - 4 - k);
+            }
+            else if (n > 0) {
+                a = (uint64_t(p[0]) << 16) | (uint64_t(p[n >> 1]) << 8) | p[n - 1];
+                b = 0;
+            }
+            else a = b = 0;
+        }
+        else {
+            size_t i = n;
+            if (i > 48) {
+                uint64_t see1 = seed, see2 = seed;
+                do {
+                    seed = _mix(_r8(p) ^ _secret[1], _r8(p + 8) ^ seed);
+                    see1 = _mix(_r8(p + 16) ^ _secret[2], _r8(p + 24) ^ see1);
+                    see2 = _mix(_r8(p + 32) ^ _secret[3], _r8(p + 40) ^ see2);
+                    p += 48;
+                    i -= 48;
+                } while (i > 48);
+                seed ^= see1 ^ see2;
+            }
+            for (; i > 16; i -= 16, p += 16) seed = _mix(_r8(p) ^ _secret[1], _r8(p + 8) ^ seed);
+            a = _r8(p + i - 16);
+            b = _r8(p + i - 8);
+        }
+        return _mix(_secret[1] ^ n, _mix(a ^ _secret[1], b ^ seed));
+    }
+
+    /**
+    * bytes of a stripe hashed per call of _stripe; eight 64 bit lanes
+    */
+    constexpr _INLINE_VAR static size_t _stripe_size = 64;
+
+    /**
+    * stripes between two scrambles of the lanes
+    */
+    constexpr _INLINE_VAR static size_t _stripes = 16;
+
+    /**
+    * each lane takes the 32x32 bit product of the halves of its keyed word, and the word itself goes to the neighbouring lane
+    */
+    static void _stripe(uint64_t (&acc)[8], unsigned char const* const p, uint64_t const (&key)[8]) noexcept {
+#if defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2) || defined(__SSE2__)
+        for (size_t i = 0; i != 4; ++i) {
+            __m128i const data = _mm_loadu_si128(reinterpret_cast<__m128i const*>(p + 16 * i));
+            __m128i const keyed = _mm_xor_si128(data, _mm_loadu_si128(reinterpret_cast<__m128i const*>(key + 2 * i)));
+            __m128i const product = _mm_mul_epu32(keyed, _mm_shuffle_epi32(keyed, _MM_SHUFFLE(0, 3, 0, 1)));
+            __m128i const swapped = _mm_shuffle_epi32(data, _MM_SHUFFLE(1, 0, 3, 2));
+            __m128i* const lanes = reinterpret_cast<__m128i*>(acc + 2 * i);
+            _mm_storeu_si128(lanes, _mm_add_epi64(_mm_loadu_si128(lanes), _mm_add_epi64(product, swapped)));
+        }
+#else
+        for (size_t i = 0; i != 8; ++i) {
+            uint64_t const data = _r8(p + 8 * i);
+            uint64_t const keyed = data ^ key[i];
+            acc[i ^ 1] += data;
+            acc[i] += (keyed & 0xffffffff) * (keyed >> 32);
+        }
+#endif
+    }
+
+    static void _scramble(uint64_t (&acc)[8], uint64_t const (&key)[8]) noexcept {
+        for (size_t i = 0; i != 8; ++i) acc[i] = ((acc[i] ^ (acc[i] >> 47)) ^ key[i]) * 0x9E3779B1ull;
+    }
+
+    _NODISCARD static uint64_t _bulk(unsigned char const* const p, size_t const n, uint64_t const seed) noexcept {
+        uint64_t key[8], acc[8];
+        for (size_t i = 0; i != 8; ++i) {
+            key[i] = _mix(seed ^ _secret[i & 3], _secret[(i + 1) & 3] + i);
+            acc[i] = _secret[i & 3] ^ seed;
+        }
+        size_t const stripes = n / _stripe_size;
+        for (size_t s = 0; s != stripes; ++s) {
+            _stripe(acc, p + s * _stripe_size, key);
+            if (s % _stripes == _stripes - 1) _scramble(acc, key);
+        }
+        _stripe(acc, p + n - _stripe_size, key);
+
+        uint64_t res = n * 0x9E3779B97F4A7C15ull;
+        for (size_t i = 0; i != 4; ++i) res = _mix(res ^ acc[2 * i] ^ _secret[i], acc[2 * i + 1] ^ key[2 * i]);
+        return _mix(res ^ _secret[0], n ^ _secret[1]);
+    }
+
+    template<class T> _NODISCARD static type_if<uint64_t, _bytewise<T>::value> _hash(T const& value, uint64_t const seed) noexcept {
+        return bytes(std::addressof(value), sizeof(T), seed);
+    }
+
+    /**
+    * +0.0 and -0.0 compare equal and hash alike
+    */
+    template<class T> _NODISCARD static type_if<uint64_t, std::is_floating_point<T>::value> _hash(T const& value, uint64_t const seed) noexcept {
+        T const normal = value == T(0) ? T(0) : value;
+        return bytes(std::addressof(normal), sizeof(T), seed);
+    }
+
+    template<class T> _NODISCARD static type_if<uint64_t, !_bytewise<T>::value, !std::is_floating_point<T>::value> _hash(T const& value, uint64_t const seed)
+        noexcept(noexcept(std::hash<T>{}(value))) {
+        return combine(seed, uint64_t(std::hash<T>{}(value)));
+    }
+
+    template<class T> _NODISCARD static uint64_t _hash_n(T const* const data, size_t const n, uint64_t const seed, true_type) noexcept {
+        return bytes(data, n * sizeof(T), seed);
+    }
+
+    /**
+    * no elements hash as no bytes, as they do over a bytewise T
+    */
+    template<class T> _NODISCARD static uint64_t _hash_n(T const* const data, size_t const n, uint64_t const seed, false_type)
+        noexcept(noexcept(_hash(*data, seed))) {
+        if (!n) return bytes(nullptr, 0, seed);
+        uint64_t res = combine(seed, n);
+        for (size_t i = 0; i != n; ++i) res = combine(res, _hash(data[i], seed));
+        return res;
+    }
+
+    template<class T, size_t N> _NODISCARD static uint64_t _hash(array<T, N> const& arr, uint64_t const seed) noexcept(noexcept(_hash(arr[0], seed))) {
+        return _hash_n(arr.data(), N, seed, _bytewise<T>{});
+    }
+
+    template<class T, size_t N, size_t M, size_t... K> _NODISCARD static uint64_t _hash(array<T, N, M, K...> const& arr, uint64_t const seed)
+        noexcept(noexcept(_hash(static_cast<array<array<T, M, K...>, N> const&>(arr), seed))) {
+        return _hash(static_cast<array<array<T, M, K...>, N> const&>(arr), seed);
+    }
+
+    template<class T> _NODISCARD static uint64_t _hash(array<T, 0> const&, uint64_t const seed) noexcept {
+        return bytes(nullptr, 0, seed);
+    }
+
+    /**
+    * equal to the hash of an array<T, N> of the same elements
+    */
+    template<class T> _NODISCARD static uint64_t _hash(array<T> const& arr, uint64_t const seed) noexcept(noexcept(_hash(arr[0], seed))) {
+        return _hash_n(arr.data(), arr.size(), seed, _bytewise<T>{});
+    }
+
+    template<class A, class B> _NODISCARD static uint64_t _hash(pair<A, B> const& value, uint64_t const seed)
+        noexcept(noexcept(_hash(value.first, seed)) && noexcept(_hash(value.second, seed))) {
+        return combine(_hash(value.first, seed), _hash(value.second, seed));
+    }
+
+    template<class T> _NODISCARD static uint64_t _hash(optional<T> const& value, uint64_t const seed) noexcept(noexcept(_hash(*value, seed))) {
+        return value.has_value() ? combine(seed ^ _secret[2], _hash(*value, seed)) : combine(seed, _secret[3]);
+    }
+};
+
+namespace std
+{
+    template<class T, size_t... N>
+    struct hash<::array<T, N...>> {
+        _NODISCARD size_t operator()(::array<T, N...> const& value) const noexcept(noexcept(::hasher{}(value))) { return ::hasher{}(value); }
+    };
+
+    template<class First, class Second>
+    struct hash<::pair<First, Second>> {
+        _NODISCARD size_t operator()(::pair<First, Second> const& value) const noexcept(noexcept(::hasher{}(value))) { return ::hasher{}(value); }
+    };
+
+    template<class T>
+    struct hash<::optional<T>> {
+        _NODISCARD size_t operator()(::optional<T> const& value) const noexcept(noexcept(::hasher{}(value))) { return ::hasher{}(value); }
+    };
+}
+
+#endif // !__HASH_HPP
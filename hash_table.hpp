@@ -0,0 +1,522 @@
+#ifndef __HASH_TABLE_HPP
+#define __HASH_TABLE_HPP 1
+
+#include "util.hpp"
+#include "object.hpp"
+#include "pair.hpp"
+#include "algorithm.hpp"
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+
+#if defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2) || defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+template<class...> struct hash_table;
+
+using hash_tables = hash_table<>;
+
+/**
+* control bytes of an open-addressing table: one per slot, empty, deleted or the low 7 bits of the hash of the key.
+* A probe compares a whole group of them at once against the hash, and only then the keys
+*/
+template<> struct hash_table<> {
+protected:
+    using _ctrl_t = signed char;
+
+    constexpr _INLINE_VAR static _ctrl_t _empty = -128;
+    constexpr _INLINE_VAR static _ctrl_t _deleted = -2;
+
+#if defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2) || defined(__SSE2__)
+    constexpr _INLINE_VAR static size_t _group = 16;
+
+    /**
+    * one bit per slot
+    */
+    constexpr _INLINE_VAR static int _shift = 0;
+
+    static uint64_t _match(_ctrl_t const* const group, _ctrl_t const h2) noexcept {
+        __m128i const ctrl = _mm_loadu_si128(reinterpret_cast<__m128i const*>(group));
+        return uint32_t(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), ctrl)));
+    }
+
+    static uint64_t _match_empty(_ctrl_t const* const group) noexcept { return _match(group, _empty); }
+
+    /**
+    * the sign bit is set for empty and deleted slots only
+    */
+    static uint64_t _match_free(_ctrl_t const* const group) noexcept {
+        return uint32_t(_mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<__m128i const*>(group))));
+    }
+#else
+    constexpr _INLINE_VAR static size_t _group = 8;
+
+    /**
+    * the high bit of a byte per slot
+    */
+    constexpr _INLINE_VAR static int _shift = 3;
+
+    constexpr _INLINE_VAR static uint64_t _lsbs = 0x0101010101010101ull;
+    constexpr _INLINE_VAR static uint64_t _msbs = 0x8080808080808080ull;
+
+    static uint64_t _load(_ctrl_t const* const group) noexcept {
+        uint64_t word;
+        std::memcpy(&word, group, sizeof word);
+        return word;
+    }
+
+    /**
+    * may report a false positive above a true one, the keys are compared anyway
+    */
+    static uint64_t _match(_ctrl_t const* const group, _ctrl_t const h2) noexcept {
+        uint64_t const x = _load(group) ^ (_lsbs * uint8_t(h2));
+        return (x - _lsbs) & ~x & _msbs;
+    }
+
+    static uint64_t _match_empty(_ctrl_t const* const group) noexcept {
+        uint64_t const word = _load(group);
+        return word & ~(word << 6) & _msbs;
+    }
+
+    static uint64_t _match_free(_ctrl_t const* const group) noexcept {
+        uint64_t const word = _load(group);
+        return word & ~(word << 7) & _msbs;
+    }
+#endif
+
+    _NODISCARD static size_t _offset(uint64_t const mask) noexcept { return size_t(algorithms::countr_zero(mask)) >> _shift; }
+
+    /**
+    * spreads weak hashes (identity for integers) over all bits
+    */
+    _NODISCARD static uint64_t _mix(size_t const hash) noexcept {
+        uint64_t const x = uint64_t(hash) * 0x9E3779B97F4A7C15ull;
+        return x ^ (x >> 32);
+    }
+
+    /**
+    * the control bytes of a table without slots: probes end at once
+    */
+    _NODISCARD static _ctrl_t* _no_slots() noexcept {
+        static _ctrl_t empties[16] = {
+            _empty, _empty, _empty, _empty, _empty, _empty, _empty, _empty,
+            _empty, _empty, _empty, _empty, _empty, _empty, _empty, _empty
+        };
+        return empties;
+    }
+
+    struct _first {
+        template<class P> constexpr auto operator()(P& p) const noexcept -> decltype((p.first)) { return p.first; }
+    };
+
+    struct _self {
+        template<class K> constexpr K& operator()(K& k) const noexcept { return k; }
+    };
+
+    template<class...> friend struct hash_table;
+};
+
+/**
+* open addressing over a power of two count of slots, at most 7/8 full; erased slots are left as tombstones until the next rehash
+* @param [] Slot - the stored element
+* @param [] KeyOf - extracts the key from a slot
+*/
+template<class Slot, class KeyOf, class Hash, class Eq> struct hash_table<Slot, KeyOf, Hash, Eq> : hash_table<> {
+    using key_type = remove_cvref_t<decltype(KeyOf{}(std::declval<Slot&>()))>;
+    using value_type = Slot;
+    using size_type = size_t;
+    using hasher = Hash;
+    using key_equal = Eq;
+
+    template<bool Const> struct _iterator {
+        using value_type = Slot;
+        using difference_type = ptrdiff_t;
+        using pointer = conditional<Const, Slot const*, Slot*>;
+        using reference = conditional<Const, Slot const&, Slot&>;
+        using iterator_category = std::forward_iterator_tag;
+
+        constexpr _iterator() noexcept : m_ctrl(nullptr), m_end(nullptr), m_slot(nullptr) {}
+
+        _iterator(_ctrl_t const* const ctrl, _ctrl_t const* const end, pointer const slot) noexcept : m_ctrl(ctrl), m_end(end), m_slot(slot) {}
+
+        template<bool C = Const, type_if<int, C> = 0>
+        _iterator(_iterator<false> const& other) noexcept : m_ctrl(other.m_ctrl), m_end(other.m_end), m_slot(other.m_slot) {}
+
+        _NODISCARD reference operator*() const noexcept { return *m_slot; }
+
+        _NODISCARD pointer operator->() const noexcept { return m_slot; }
+
+        _iterator& operator++() noexcept {
+            ++m_ctrl;
+            ++m_slot;
+            _skip();
+            return *this;
+        }
+
+        _iterator operator++(int) noexcept {
+            _iterator res = *this;
+            ++*this;
+            return res;
+        }
+
+        template<bool C> _NODISCARD bool operator==(_iterator<C> const& other) const noexcept { return m_ctrl == other.m_ctrl; }
+
+        template<bool C> _NODISCARD bool operator!=(_iterator<C> const& other) const noexcept { return m_ctrl != other.m_ctrl; }
+
+        void _skip() noexcept {
+            for (; m_ctrl != m_end && *m_ctrl < 0; ++m_ctrl, ++m_slot) {}
+        }
+
+    protected:
+        _ctrl_t const* m_ctrl;
+        _ctrl_t const* m_end;
+        pointer m_slot;
+
+        template<class...> friend struct hash_table;
+        template<bool> friend struct _iterator;
+    };
+
+    /**
+    * a set exposes its keys read-only
+    */
+    using iterator = _iterator<is_same_v<Slot, key_type>>;
+    using const_iterator = _iterator<true>;
+
+    hash_table() noexcept(std::is_nothrow_default_constructible<Hash>::value && std::is_nothrow_default_constructible<Eq>::value)
+        : m_ctrl(_no_slots()), m_slots(nullptr), m_capacity(0), m_size(0), m_growth(0), m_hash(), m_eq() {
+    }
+
+    explicit hash_table(size_type const n, Hash const& hash = Hash{}, Eq const& eq = Eq{})
+        : m_ctrl(_no_slots()), m_slots(nullptr), m_capacity(0), m_size(0), m_growth(0), m_hash(hash), m_eq(eq) {
+        reserve(n);
+    }
+
+    hash_table(hash_table const& other) : hash_table(other.m_size, other.m_hash, other.m_eq) {
+        for (auto const& slot : other) _insert(slot);
+    }
+
+    hash_table(hash_table&& other) noexcept(std::is_nothrow_copy_constructible<Hash>::value && std::is_nothrow_copy_constructible<Eq>::value)
+        : hash_table(_functors{}, other.m_hash, other.m_eq) {
+        _swap_slots(other);
+    }
+
+    hash_table& operator=(hash_table other) noexcept {
+        swap(other);
+        return *this;
+    }
+
+    ~hash_table() noexcept {
+        _release();
+    }
+
+    void swap(hash_table& other) noexcept {
+        _swap_slots(other);
+        std::swap(m_hash, other.m_hash);
+        std::swap(m_eq, other.m_eq);
+    }
+
+    _NODISCARD size_type size() const noexcept { return m_size; }
+
+    _NODISCARD bool empty() const noexcept { return m_size == 0; }
+
+    _NODISCARD size_type capacity() const noexcept { return m_capacity; }
+
+    _NODISCARD iterator begin() noexcept { return _at(0); }
+    _NODISCARD const_iterator begin() const noexcept { return _at(0); }
+    _NODISCARD const_iterator cbegin() const noexcept { return begin(); }
+
+    _NODISCARD iterator end() noexcept { return { m_ctrl + m_capacity, m_ctrl + m_capacity, m_slots + m_capacity }; }
+    _NODISCARD const_iterator end() const noexcept { return { m_ctrl + m_capacity, m_ctrl + m_capacity, m_slots + m_capacity }; }
+    _NODISCARD const_iterator cend() const noexcept { return end(); }
+
+    /**
+    * makes room for n elements without rehashing
+    */
+    void reserve(size_type const n) {
+        size_t capacity = m_capacity ? m_capacity : _group;
+        while (capacity - capacity / 8 < n) capacity *= 2;
+        if (capacity != m_capacity && (n > m_size || !m_capacity)) _rehash(capacity);
+    }
+
+    void clear() noexcept {
+        _destroy();
+        std::memset(m_ctrl, _empty, m_capacity ? m_capacity + _group : 0);
+        m_size = 0;
+        m_growth = m_capacity - m_capacity / 8;
+    }
+
+    _NODISCARD iterator find(key_type const& key) noexcept { return _found(_find(key, _hash_of(key))); }
+
+    _NODISCARD const_iterator find(key_type const& key) const noexcept { return _found(_find(key, _hash_of(key))); }
+
+    /**
+    * heterogeneous lookup, when both the hasher and the equality are transparent
+    */
+    template<class U, class H = Hash, class E = Eq, class = typename H::is_transparent, class = typename E::is_transparent>
+    _NODISCARD iterator find(U const& key) noexcept { return _found(_find(key, _hash_of(key))); }
+
+    template<class U, class H = Hash, class E = Eq, class = typename H::is_transparent, class = typename E::is_transparent>
+    _NODISCARD const_iterator find(U const& key) const noexcept { return _found(_find(key, _hash_of(key))); }
+
+    _NODISCARD bool contains(key_type const& key) const noexcept { return _find(key, _hash_of(key)) != _npos; }
+
+    template<class U, class H = Hash, class E = Eq, class = typename H::is_transparent, class = typename E::is_transparent>
+    _NODISCARD bool contains(U const& key) const noexcept { return _find(key, _hash_of(key)) != _npos; }
+
+    _NODISCARD size_type count(key_type const& key) const noexcept { return contains(key); }
+
+    pair<iterator, bool> insert(Slot const& slot) { return _insert(slot); }
+
+    pair<iterator, bool> insert(Slot&& slot) { return _insert(static_cast<Slot&&>(slot)); }
+
+    /**
+    * the slot is built first to get its key; it is dropped if the key is present
+    */
+    template<class... Args>
+    type_if<pair<iterator, bool>, is_constructible_v<Slot, Args&&...>> emplace(Args&&... args) {
+        Slot slot(static_cast<Args&&>(args)...);
+        return _insert(static_cast<Slot&&>(slot));
+    }
+
+    size_type erase(key_type const& key) noexcept {
+        size_t const i = _find(key, _hash_of(key));
+        if (i == _npos) return 0;
+        _erase(i);
+        return 1;
+    }
+
+    template<class U, class H = Hash, class E = Eq, class = typename H::is_transparent, class = typename E::is_transparent>
+    size_type erase(U const& key) noexcept {
+        size_t const i = _find(key, _hash_of(key));
+        if (i == _npos) return 0;
+        _erase(i);
+        return 1;
+    }
+
+    iterator erase(const_iterator pos) noexcept {
+        size_t const i = size_t(pos.m_ctrl - m_ctrl);
+        _erase(i);
+        return _at(i + 1);
+    }
+
+    template<class Proc>
+    type_if<size_type, util::invocable_v<Proc&, typename iterator::reference>> foreach(Proc&& proc) {
+        for (auto i = begin(), e = end(); i != e; ++i) util::invoke(proc, *i);
+        return m_size;
+    }
+
+    template<class Proc>
+    type_if<size_type, util::invocable_v<Proc&, Slot const&>> foreach(Proc&& proc) const {
+        for (auto i = begin(), e = end(); i != e; ++i) util::invoke(proc, *i);
+        return m_size;
+    }
+
+protected:
+    constexpr _INLINE_VAR static size_t _npos = size_t(-1);
+
+    _ctrl_t* m_ctrl;
+    Slot* m_slots;
+    size_t m_capacity;
+    size_t m_size;
+
+    /**
+    * the count of empty slots that may still be taken before a rehash
+    */
+    size_t m_growth;
+
+    Hash m_hash;
+    Eq m_eq;
+
+    struct _functors {};
+
+    /**
+    * no slots; Hash and Eq need be neither default constructible nor assignable
+    */
+    hash_table(_functors, Hash const& hash, Eq const& eq) noexcept(std::is_nothrow_copy_constructible<Hash>::value && std::is_nothrow_copy_constructible<Eq>::value)
+        : m_ctrl(_no_slots()), m_slots(nullptr), m_capacity(0), m_size(0), m_growth(0), m_hash(hash), m_eq(eq) {
+    }
+
+    void _swap_slots(hash_table& other) noexcept {
+        std::swap(m_ctrl, other.m_ctrl);
+        std::swap(m_slots, other.m_slots);
+        std::swap(m_capacity, other.m_capacity);
+        std::swap(m_size, other.m_size);
+        std::swap(m_growth, other.m_growth);
+    }
+
+    template<class U> _NODISCARD uint64_t _hash_of(U const& key) const noexcept { return _mix(m_hash(key)); }
+
+    _NODISCARD iterator _at(size_t const i) const noexcept {
+        iterator res{ m_ctrl + i, m_ctrl + m_capacity, m_slots + i };
+        res._skip();
+        return res;
+    }
+
+    _NODISCARD iterator _found(size_t const i) const noexcept {
+        size_t const pos = i == _npos ? m_capacity : i;
+        return { m_ctrl + pos, m_ctrl + m_capacity, m_slots + pos };
+    }
+
+    template<class U> _NODISCARD size_t _find(U const& key, uint64_t const hash) const noexcept {
+        size_t const mask = m_capacity ? m_capacity - 1 : 0;
+        _ctrl_t const h2 = _ctrl_t(hash & 0x7f);
+        size_t pos = size_t(hash >> 7) & mask;
+        for (size_t step = _group; ; step += _group) {
+            _ctrl_t const* const group = m_ctrl + pos;
+            for (uint64_t m = _match(group, h2); m; m &= m - 1) {
+                size_t const i = (pos + _offset(m)) & mask;
+                if (m_eq(KeyOf{}(m_slots[i]), key)) return i;
+            }
+            if (_match_empty(group)) return _npos;
+            pos = (pos + step) & mask;
+        }
+    }
+
+    _NODISCARD size_t _find_free(uint64_t const hash) const noexcept {
+        size_t const mask = m_capacity - 1;
+        size_t pos = size_t(hash >> 7) & mask;
+        for (size_t step = _group; ; step += _group) {
+            uint64_t const m = _match_free(m_ctrl + pos);
+            if (m) return (pos + _offset(m)) & mask;
+            pos = (pos + step) & mask;
+        }
+    }
+
+    /**
+    * the first _group control bytes are mirrored past the end, so a group can be loaded from any slot
+    */
+    void _set_ctrl(size_t const i, _ctrl_t const ctrl) noexcept {
+        m_ctrl[i] = ctrl;
+        if (i < _group) m_ctrl[m_capacity + i] = ctrl;
+    }
+
+    template<class S> pair<iterator, bool> _insert(S&& slot) {
+        auto const& key = KeyOf{}(slot);
+        uint64_t const hash = _hash_of(key);
+        size_t i = _find(key, hash);
+        if (i != _npos) return { _found(i), false };
+        return { _found(_place(hash, static_cast<S&&>(slot))), true };
+    }
+
+    /**
+    * @return the index of the new slot, built from args
+    */
+    template<class... Args> size_t _place(uint64_t const hash, Args&&... args) {
+        if (m_growth == 0) _grow();
+        size_t const i = _find_free(hash);
+        new(m_slots + i) Slot(static_cast<Args&&>(args)...);
+        if (m_ctrl[i] == _empty) --m_growth;
+        _set_ctrl(i, _ctrl_t(hash & 0x7f));
+        ++m_size;
+        return i;
+    }
+
+    void _erase(size_t const i) noexcept {
+        m_slots[i].~Slot();
+        _set_ctrl(i, _deleted);
+        --m_size;
+    }
+
+    /**
+    * doubles the table, or only sweeps the tombstones when they make up most of the used slots
+    */
+    void _grow() {
+        if (!m_capacity) _rehash(_group);
+        else if (m_size <= (m_capacity - m_capacity / 8) / 2) _rehash(m_capacity);
+        else _rehash(m_capacity * 2);
+    }
+
+    void _rehash(size_t const capacity) {
+        hash_table fresh(_functors{}, m_hash, m_eq);
+        std::unique_ptr<_ctrl_t[]> ctrl(new _ctrl_t[capacity + _group]);
+        std::memset(ctrl.get(), _empty, capacity + _group);
+        fresh.m_slots = std::allocator<Slot>{}.allocate(capacity);
+        fresh.m_ctrl = ctrl.release();
+        fresh.m_capacity = capacity;
+        fresh.m_growth = capacity - capacity / 8;
+        for (size_t i = 0; i != m_capacity; ++i) {
+            if (m_ctrl[i] < 0) continue;
+            fresh._place(_hash_of(KeyOf{}(m_slots[i])), static_cast<Slot&&>(m_slots[i]));
+        }
+        _swap_slots(fresh);
+    }
+
+    void _destroy() noexcept {
+        for (size_t i = 0; i != m_capacity; ++i) {
+            if (m_ctrl[i] >= 0) m_slots[i].~Slot();
+        }
+    }
+
+    void _release() noexcept {
+        if (!m_capacity) return;
+        _destroy();
+        delete[] m_ctrl;
+        std::allocator<Slot>{}.deallocate(m_slots, m_capacity);
+    }
+};
+
+template<class K, class V, class Hash = std::hash<K>, class Eq = equal_to>
+struct hash_map : hash_table<pair<K, V>, hash_tables::_first, Hash, Eq> {
+    using base = hash_table<pair<K, V>, hash_tables::_first, Hash, Eq>;
+    using mapped_type = V;
+    using typename base::iterator;
+    using typename base::size_type;
+
+    using base::base;
+
+    /**
+    * inserts a value-initialized V if the key is missing
+    */
+    template<class U = V, type_if<int, is_constructible_v<U>> = 0>
+    V& operator[](K const& key) {
+        return try_emplace(key).first->second;
+    }
+
+    template<class U = V, type_if<int, is_constructible_v<U>> = 0>
+    V& operator[](K&& key) {
+        return try_emplace(static_cast<K&&>(key)).first->second;
+    }
+
+    _NODISCARD V& at(K const& key) {
+        auto const i = this->find(key);
+        if (i == this->end())
+            std::_Xout_of_range("hash_map::at");
+        return i->second;
+    }
+
+    _NODISCARD V const& at(K const& key) const {
+        auto const i = this->find(key);
+        if (i == this->end())
+            std::_Xout_of_range("hash_map::at");
+        return i->second;
+    }
+
+    /**
+    * V is built from args only if the key is missing
+    */
+    template<class Key, class... Args, type_if<int, is_constructible_v<K, Key&&>, is_constructible_v<V, Args&&...>> = 0>
+    pair<iterator, bool> try_emplace(Key&& key, Args&&... args) {
+        uint64_t const hash = this->_hash_of(key);
+        size_t const i = this->_find(key, hash);
+        if (i != base::_npos) return { this->_found(i), false };
+        return { this->_found(this->_place(hash, K(static_cast<Key&&>(key)), V(static_cast<Args&&>(args)...))), true };
+    }
+
+    template<class Key, class U, type_if<int, is_constructible_v<K, Key&&>, is_assignable_v<V&, U&&>> = 0>
+    pair<iterator, bool> insert_or_assign(Key&& key, U&& value) {
+        auto res = try_emplace(static_cast<Key&&>(key), static_cast<U&&>(value));
+        if (!res.second) res.first->second = static_cast<U&&>(value);
+        return res;
+    }
+};
+
+template<class K, class Hash = std::hash<K>, class Eq = equal_to>
+struct hash_set : hash_table<K, hash_tables::_self, Hash, Eq> {
+    using base = hash_table<K, hash_tables::_self, Hash, Eq>;
+
+    using base::base;
+};
+
+#endif // !__HASH_TABLE_HPP
@@ -0,0 +1,358 @@
+#ifndef __HEAP_HPP
+#define __HEAP_HPP 1
+
+#include "util.hpp"
+#include "object.hpp"
+#include "comporator.hpp"
+#include "pair.hpp"
+#include "array.hpp"
+#include "algorithm.hpp"
+#include <cstdint>
+#include <type_traits>
+
+/**
+* d-ary heap kernels over contiguous elements: the element ordered first by the comparator is at the top,
+* so with the default_comporator it is a min-heap, as the minimum of a tree_node
+*/
+struct heaps {
+    /**
+    * Floyd's bottom-up construction, O(n)
+    */
+    template<size_t D, class T, class Comp> static void make_heap(T* const data, size_t const n, Comp const& comp) {
+        if (n < 2) return;
+        auto&& less = _less(comp);
+        for (size_t i = (n - 2) / D + 1; i != 0; ) {
+            --i;
+            T value = static_cast<T&&>(data[i]);
+            _sift_down<D>(data, n, i, value, less);
+        }
+    }
+
+    /**
+    * @param [] n - the size including the new element at data[n - 1]
+    */
+    template<size_t D, class T, class Comp> static void push_heap(T* const data, size_t const n, Comp const& comp) {
+        if (n < 2) return;
+        auto&& less = _less(comp);
+        T value = static_cast<T&&>(data[n - 1]);
+        size_t i = n - 1;
+        while (i != 0) {
+            size_t const parent = (i - 1) / D;
+            if (!less(value, data[parent])) break;
+            data[i] = static_cast<T&&>(data[parent]);
+            i = parent;
+        }
+        data[i] = static_cast<T&&>(value);
+    }
+
+    /**
+    * moves the top to data[n - 1] and restores the heap over the first n - 1 elements
+    */
+    template<size_t D, class T, class Comp> static void pop_heap(T* const data, size_t const n, Comp const& comp) {
+        if (n < 2) return;
+        T value = static_cast<T&&>(data[n - 1]);
+        data[n - 1] = static_cast<T&&>(data[0]);
+        _sift_down<D>(data, n - 1, 0, value, _less(comp));
+    }
+
+    template<size_t D, class T, class Comp> _NODISCARD static bool is_heap(T const* const data, size_t const n, Comp const& comp) {
+        auto&& less = _less(comp);
+        for (size_t i = 1; i < n; ++i) {
+            if (less(data[i], data[(i - 1) / D])) return false;
+        }
+        return true;
+    }
+
+protected:
+    /**
+    * adapts a three-way ordering functor to a strict "less", so that a comporator costs one call per comparison rather than two
+    */
+    template<class Comp> struct _ordered {
+        Comp const& comp;
+
+        template<class L, class R> constexpr bool operator()(L const& l, R const& r) const {
+            return util::invoke(comp, l, r) < 0;
+        }
+    };
+
+    template<class Comp> constexpr static _ordered<Comp> _less(Comp const& comp) noexcept { return { comp }; }
+
+    template<class EqualTo, class Less> constexpr static Less const& _less(comporator<EqualTo, Less> const& comp) noexcept { return comp.less_than(); }
+
+    /**
+    * the natural order is operator<
+    */
+    constexpr static less _less(default_comporator const&) noexcept { return {}; }
+
+    /**
+    * moves the hole at i down to where value belongs: one move per level instead of a swap
+    */
+    template<size_t D, class T, class Less> static void _sift_down(T* const data, size_t const n, size_t i, T& value, Less const& less) {
+        for (;;) {
+            size_t const first = i * D + 1;
+            if (first >= n) break;
+            size_t const last = n - first < D ? n : first + D;
+            size_t best = first;
+            for (size_t c = first + 1; c < last; ++c) {
+                if (less(data[c], data[best])) best = c;
+            }
+            if (!less(data[best], value)) break;
+            data[i] = static_cast<T&&>(data[best]);
+            i = best;
+        }
+        data[i] = static_cast<T&&>(value);
+    }
+
+    /**
+    * array<T> storage that grows by doubling; the slots past the size hold moved-from or default values
+    */
+    template<class T> struct _buffer {
+        _buffer() noexcept : m_elems(), m_size(0) {}
+
+        explicit _buffer(array<T>&& elems) noexcept : m_elems(static_cast<array<T>&&>(elems)), m_size(m_elems.size()) {}
+
+        _buffer(_buffer const& other) : m_elems(other.m_elems), m_size(other.m_size) {}
+
+        _buffer(_buffer&& other) noexcept : m_elems(static_cast<array<T>&&>(other.m_elems)), m_size(other.m_size) {
+            other.m_size = 0;
+        }
+
+        _buffer& operator=(_buffer other) noexcept {
+            swap(other);
+            return *this;
+        }
+
+        void swap(_buffer& other) noexcept {
+            m_elems.swap(other.m_elems);
+            size_t const size = m_size;
+            m_size = other.m_size;
+            other.m_size = size;
+        }
+
+        void reserve(size_t const n) {
+            if (n <= m_elems.size()) return;
+            array<T> elems{ arrays::for_overwrite, n };
+            for (size_t i = 0; i != m_size; ++i) elems.data()[i] = static_cast<T&&>(m_elems.data()[i]);
+            m_elems.swap(elems);
+        }
+
+        template<class V> void push_back(V&& value) {
+            if (m_size == m_elems.size()) reserve(m_size ? m_size * 2 : 8);
+            m_elems.data()[m_size++] = static_cast<V&&>(value);
+        }
+
+        T* data() noexcept { return m_elems.data(); }
+
+        T const* data() const noexcept { return m_elems.data(); }
+
+        array<T> m_elems;
+        size_t m_size;
+    };
+
+    template<class, size_t, class> friend struct heap;
+    template<class, class> friend struct radix_heap;
+};
+
+/**
+* priority queue over an array<T>, the top ordered first by Comparator
+* @param [] D - the arity; 4 halves the depth of a binary heap and keeps a node's children of 16 bytes or less within a cache line
+*/
+template<class T, size_t D = 4, class Comparator = default_comporator> struct heap : protected object<Comparator> {
+    static_assert(D >= 2, "D < 2");
+
+    using value_type = T;
+    using size_type = size_t;
+    using reference = T&;
+    using const_reference = T const&;
+    using comporator_t = object<Comparator>;
+
+    constexpr _INLINE_VAR static size_t arity = D;
+
+    heap() noexcept(is_nothrow_constructible_v<comporator_t>) : comporator_t(), m_buffer() {}
+
+    explicit heap(Comparator const& cmp) noexcept(is_nothrow_constructible_v<comporator_t, Comparator const&>) : comporator_t(cmp), m_buffer() {}
+
+    /**
+    * takes the elements and heapifies them at once
+    */
+    explicit heap(array<T>&& elems, Comparator const& cmp = Comparator()) : comporator_t(cmp), m_buffer(static_cast<array<T>&&>(elems)) {
+        heaps::make_heap<D>(m_buffer.data(), m_buffer.m_size, _comp());
+    }
+
+    _NODISCARD size_type size() const noexcept { return m_buffer.m_size; }
+
+    _NODISCARD bool empty() const noexcept { return m_buffer.m_size == 0; }
+
+    _NODISCARD size_type capacity() const noexcept { return m_buffer.m_elems.size(); }
+
+    void reserve(size_type const n) { m_buffer.reserve(n); }
+
+    void clear() noexcept { m_buffer.m_size = 0; }
+
+    /**
+    * the element ordered first
+    */
+    _NODISCARD const_reference top() const {
+        if (empty())
+            std::_Xout_of_range("heap::top");
+        return m_buffer.data()[0];
+    }
+
+    template<class V, type_if<int, is_assignable_v<T&, V&&>> = 0>
+    void push(V&& value) {
+        m_buffer.push_back(static_cast<V&&>(value));
+        heaps::push_heap<D>(m_buffer.data(), m_buffer.m_size, _comp());
+    }
+
+    /**
+    * appends n elements; when they outnumber the heap they are heapified together rather than sifted up one by one
+    */
+    void push(T const* const data, size_type const n) {
+        size_t const size = m_buffer.m_size;
+        m_buffer.reserve(size + n);
+        for (size_t i = 0; i != n; ++i) m_buffer.data()[size + i] = data[i];
+        m_buffer.m_size = size + n;
+        if (n > size) heaps::make_heap<D>(m_buffer.data(), m_buffer.m_size, _comp());
+        else {
+            for (size_t i = size + 1; i <= size + n; ++i) heaps::push_heap<D>(m_buffer.data(), i, _comp());
+        }
+    }
+
+    void pop() {
+        if (empty())
+            std::_Xout_of_range("heap::pop");
+        heaps::pop_heap<D>(m_buffer.data(), m_buffer.m_size, _comp());
+        --m_buffer.m_size;
+    }
+
+    /**
+    * @return false if empty
+    */
+    bool pop(T& out) {
+        if (empty()) return false;
+        heaps::pop_heap<D>(m_buffer.data(), m_buffer.m_size, _comp());
+        out = static_cast<T&&>(m_buffer.data()[--m_buffer.m_size]);
+        return true;
+    }
+
+    /**
+    * visits the elements in storage order, which is not sorted
+    */
+    template<class Proc, class... Args>
+    type_if<size_type, util::invocable_v<Proc, const_reference, Args...>> foreach(Proc&& proc, Args&&... args) const {
+        T const* const data = m_buffer.data();
+        for (size_t i = 0; i != m_buffer.m_size; ++i) util::invoke(proc, data[i], args...);
+        return m_buffer.m_size;
+    }
+
+protected:
+    heaps::_buffer<T> m_buffer;
+
+    _NODISCARD Comparator const& _comp() const noexcept { return static_cast<Comparator const&>(*this); }
+};
+
+template<class T, class Comparator = default_comporator> using binary_heap = heap<T, 2, Comparator>;
+
+/**
+* monotone priority queue of unsigned integer keys: a key pushed must not be less than the last key returned by top or pop.
+* Elements go to the bucket of the highest bit in which they differ from that key, and each is moved at most once per bit,
+* so a pop is amortized O(bits) with no comparisons between elements
+* @param [] Value - carried along with the key, or void for keys alone
+*/
+template<class Key, class Value = void> struct radix_heap {
+    static_assert(std::is_integral<Key>::value && std::is_unsigned<Key>::value && sizeof(Key) <= 8, "Key is not an unsigned integer of at most 64 bits");
+
+    using key_type = Key;
+    using value_type = conditional<std::is_void<Value>::value, Key, pair<Key, Value>>;
+    using size_type = size_t;
+    using const_reference = value_type const&;
+
+    radix_heap() noexcept : m_buckets(), m_last(0), m_size(0) {}
+
+    _NODISCARD size_type size() const noexcept { return m_size; }
+
+    _NODISCARD bool empty() const noexcept { return m_size == 0; }
+
+    template<class V, type_if<int, is_assignable_v<value_type&, V&&>> = 0>
+    void push(V&& value) {
+        Key const key = _key(value);
+        m_buckets[_bucket(key)].push_back(static_cast<V&&>(value));
+        ++m_size;
+    }
+
+    /**
+    * the element of the least key; pulls the next bucket down first if needed
+    */
+    _NODISCARD const_reference top() {
+        if (empty())
+            std::_Xout_of_range("radix_heap::top");
+        _refill();
+        auto& bucket = m_buckets[0];
+        return bucket.data()[bucket.m_size - 1];
+    }
+
+    void pop() {
+        if (empty())
+            std::_Xout_of_range("radix_heap::pop");
+        _refill();
+        --m_buckets[0].m_size;
+        --m_size;
+    }
+
+    /**
+    * @return false if empty
+    */
+    bool pop(value_type& out) {
+        if (empty()) return false;
+        _refill();
+        auto& bucket = m_buckets[0];
+        out = static_cast<value_type&&>(bucket.data()[--bucket.m_size]);
+        --m_size;
+        return true;
+    }
+
+    void clear() noexcept {
+        for (auto& bucket : m_buckets) bucket.m_size = 0;
+        m_last = 0;
+        m_size = 0;
+    }
+
+protected:
+    constexpr _INLINE_VAR static size_t _bits = sizeof(Key) * 8;
+
+    /**
+    * bucket 0 holds the keys equal to m_last, bucket b those differing from it first at bit b - 1
+    */
+    heaps::_buffer<value_type> m_buckets[_bits + 1];
+    Key m_last;
+    size_t m_size;
+
+    _NODISCARD static Key _key(Key const& value) noexcept { return value; }
+
+    template<class P> _NODISCARD static Key _key(P const& value) noexcept { return value.first; }
+
+    _NODISCARD size_t _bucket(Key const key) const noexcept {
+        return size_t(algorithms::bit_width(uint64_t(key ^ m_last)));
+    }
+
+    /**
+    * only on a heap that is not empty
+    */
+    void _refill() {
+        if (m_buckets[0].m_size) return;
+        size_t b = 1;
+        while (!m_buckets[b].m_size) ++b;
+        auto& bucket = m_buckets[b];
+        value_type* const data = bucket.data();
+        Key least = _key(data[0]);
+        for (size_t i = 1; i != bucket.m_size; ++i) {
+            Key const key = _key(data[i]);
+            if (key < least) least = key;
+        }
+        m_last = least;
+        for (size_t i = 0; i != bucket.m_size; ++i) m_buckets[_bucket(_key(data[i]))].push_back(static_cast<value_type&&>(data[i]));
+        bucket.m_size = 0;
+    }
+};
+
+#endif // !__HEAP_HPP
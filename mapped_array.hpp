@@ -0,0 +1,260 @@
+#ifndef __MAPPED_ARRAY_HPP
+#define __MAPPED_ARRAY_HPP 1
+
+#include "util.hpp"
+#include "object.hpp"
+#include "iterator.hpp"
+#include <new>
+#include <system_error>
+#include <type_traits>
+
+#if defined(_WIN32)
+// keeps the min and max macros away from the min and max members declared after this header
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif // !NOMINMAX
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif // !WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cerrno>
+#endif // _WIN32
+
+enum class map_mode : unsigned char {
+    read_only,
+    /**
+    * writes go to private pages and never reach the file
+    */
+    copy_on_write
+};
+
+enum class access_hint : unsigned char {
+    normal,
+    sequential,
+    random,
+    will_need
+};
+
+/**
+* the elements of a file mapped in place, unmapped on destruction: nothing is read until touched
+* @param [] T - trivially copyable, the file holds its raw representation
+* @param [] Mode - read_only maps the pages read only, so every access is const; copy_on_write gives mutable access
+*/
+template<class T, map_mode Mode = map_mode::read_only> struct mapped_array {
+    static_assert(std::is_trivially_copyable<T>::value, "T is not trivially copyable");
+
+    constexpr _INLINE_VAR static map_mode mode = Mode;
+
+    using value_type = T;
+    using size_type = size_t;
+    using difference_type = ptrdiff_t;
+    using pointer = conditional<Mode == map_mode::copy_on_write, T*, T const*>;
+    using const_pointer = T const*;
+    using reference = conditional<Mode == map_mode::copy_on_write, T&, T const&>;
+    using const_reference = T const&;
+
+    using iterator = ::iterator<pointer>;
+    using const_iterator = ::iterator<const_pointer>;
+
+    constexpr mapped_array() noexcept : m_elems(nullptr), m_size(0), m_bytes(0) {
+    }
+
+    /**
+    * @param [] path - trailing bytes not filling a whole T are ignored
+    * @throw std::system_error if the file cannot be mapped
+    */
+    explicit mapped_array(char const* const path) : mapped_array() {
+        if (!_map(path))
+            throw std::system_error(_last_error(), std::system_category(), "mapped_array");
+    }
+
+    /**
+    * left empty if the file cannot be mapped
+    */
+    mapped_array(std::nothrow_t, char const* const path) noexcept : mapped_array() {
+        _map(path);
+    }
+
+    mapped_array(mapped_array&& other) noexcept : m_elems(other.m_elems), m_size(other.m_size), m_bytes(other.m_bytes) {
+        other.m_elems = nullptr;
+        other.m_size = other.m_bytes = 0;
+    }
+
+    mapped_array(mapped_array const&) = delete;
+
+    mapped_array& operator=(mapped_array&& other) noexcept {
+        if (this != &other) {
+            _unmap();
+            m_elems = other.m_elems;
+            m_size = other.m_size;
+            m_bytes = other.m_bytes;
+            other.m_elems = nullptr;
+            other.m_size = other.m_bytes = 0;
+        }
+        return *this;
+    }
+
+    mapped_array& operator=(mapped_array const&) = delete;
+
+    ~mapped_array() {
+        _unmap();
+    }
+
+    /**
+    * tells the system how the pages will be read; a no-op where it has no equivalent
+    */
+    void advise(access_hint const hint) const noexcept {
+        if (!m_bytes) return;
+#if defined(_WIN32)
+#if _WIN32_WINNT >= 0x0602
+        if (hint == access_hint::will_need) {
+            WIN32_MEMORY_RANGE_ENTRY range{ m_elems, m_bytes };
+            PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+        }
+#else
+        (void)hint;
+#endif // _WIN32_WINNT >= 0x0602
+#else
+        int const advice = hint == access_hint::sequential ? MADV_SEQUENTIAL
+            : hint == access_hint::random ? MADV_RANDOM
+            : hint == access_hint::will_need ? MADV_WILLNEED
+            : MADV_NORMAL;
+        ::madvise(static_cast<void*>(m_elems), m_bytes, advice);
+#endif // _WIN32
+    }
+
+    _NODISCARD size_type size() const noexcept { return m_size; }
+
+    _NODISCARD bool empty() const noexcept { return m_size == 0; }
+
+    _NODISCARD pointer data() noexcept { return m_elems; }
+
+    _NODISCARD const_pointer data() const noexcept { return m_elems; }
+
+    _NODISCARD iterator begin() noexcept { return m_elems; }
+    _NODISCARD const_iterator begin() const noexcept { return m_elems; }
+
+    _NODISCARD iterator end() noexcept { return m_elems + m_size; }
+    _NODISCARD const_iterator end() const noexcept { return m_elems + m_size; }
+
+    _NODISCARD reference operator[](size_type pos) noexcept { return m_elems[pos]; }
+
+    _NODISCARD const_reference operator[](size_type pos) const noexcept { return m_elems[pos]; }
+
+    _NODISCARD reference at(size_type pos) {
+        _check(pos);
+        return m_elems[pos];
+    }
+
+    _NODISCARD const_reference at(size_type pos) const {
+        _check(pos);
+        return m_elems[pos];
+    }
+
+    template<class Proc, class... Args>
+    type_if<size_type, util::invocable_v<Proc, reference, Args...>> foreach(Proc&& proc, Args&&... args) {
+        for (pointer i = m_elems, end = m_elems + m_size; i != end; ++i) util::invoke(proc, *i, args...);
+        return m_size;
+    }
+
+    template<class Proc, class... Args>
+    type_if<size_type, util::invocable_v<Proc, const_reference, Args...>> foreach(Proc&& proc, Args&&... args) const {
+        for (const_pointer i = m_elems, end = m_elems + m_size; i != end; ++i) util::invoke(proc, *i, args...);
+        return m_size;
+    }
+
+    template<class Proc, class... Args>
+    type_if<size_type, util::invocable_v<Proc, reference, Args...>> rforeach(Proc&& proc, Args&&... args) {
+        for (pointer i = m_elems + m_size; i != m_elems; ) util::invoke(proc, *--i, args...);
+        return m_size;
+    }
+
+    template<class Proc, class... Args>
+    type_if<size_type, util::invocable_v<Proc, const_reference, Args...>> rforeach(Proc&& proc, Args&&... args) const {
+        for (const_pointer i = m_elems + m_size; i != m_elems; ) util::invoke(proc, *--i, args...);
+        return m_size;
+    }
+
+protected:
+    T* m_elems;
+    size_type m_size;
+    size_t m_bytes;
+
+    void _check(size_type const pos) const {
+        if (pos >= m_size)
+            std::_Xout_of_range("mapped_array::at");
+    }
+
+#if defined(_WIN32)
+    static int _last_error() noexcept { return int(GetLastError()); }
+
+    /**
+    * an empty file maps to an empty array
+    */
+    bool _map(char const* const path) noexcept {
+        HANDLE const file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE) return false;
+        LARGE_INTEGER size;
+        bool ok = GetFileSizeEx(file, &size) != 0;
+        if (ok && size.QuadPart != 0) {
+            HANDLE const mapping = CreateFileMappingA(file, nullptr, Mode == map_mode::copy_on_write ? PAGE_WRITECOPY : PAGE_READONLY, 0, 0, nullptr);
+            ok = mapping != nullptr;
+            if (ok) {
+                void* const view = MapViewOfFile(mapping, Mode == map_mode::copy_on_write ? FILE_MAP_COPY : FILE_MAP_READ, 0, 0, 0);
+                ok = view != nullptr;
+                if (ok) {
+                    m_elems = static_cast<T*>(view);
+                    m_bytes = size_t(size.QuadPart);
+                    m_size = m_bytes / sizeof(T);
+                }
+                DWORD const error = GetLastError();
+                CloseHandle(mapping);
+                SetLastError(error);
+            }
+        }
+        DWORD const error = GetLastError();
+        CloseHandle(file);
+        SetLastError(error);
+        return ok;
+    }
+
+    void _unmap() noexcept {
+        if (m_bytes) UnmapViewOfFile(m_elems);
+    }
+#else
+    static int _last_error() noexcept { return errno; }
+
+    bool _map(char const* const path) noexcept {
+        int const fd = ::open(path, O_RDONLY);
+        if (fd < 0) return false;
+        struct stat st;
+        bool ok = ::fstat(fd, &st) == 0;
+        if (ok && st.st_size != 0) {
+            int const prot = Mode == map_mode::copy_on_write ? PROT_READ | PROT_WRITE : PROT_READ;
+            int const flags = Mode == map_mode::copy_on_write ? MAP_PRIVATE : MAP_SHARED;
+            void* const view = ::mmap(nullptr, size_t(st.st_size), prot, flags, fd, 0);
+            ok = view != MAP_FAILED;
+            if (ok) {
+                m_elems = static_cast<T*>(view);
+                m_bytes = size_t(st.st_size);
+                m_size = m_bytes / sizeof(T);
+            }
+        }
+        int const error = errno;
+        ::close(fd);
+        errno = error;
+        return ok;
+    }
+
+    void _unmap() noexcept {
+        if (m_bytes) ::munmap(static_cast<void*>(m_elems), m_bytes);
+    }
+#endif // _WIN32
+};
+
+#endif // !__MAPPED_ARRAY_HPP
@@ -0,0 +1,212 @@
+#ifndef __MDSPAN_HPP
+#define __MDSPAN_HPP 1
+
+#include "util.hpp"
+#include "object.hpp"
+
+constexpr _INLINE_VAR size_t dynamic_extent = size_t(-1);
+
+/**
+* non-owning strided view of a multi-dimensional range
+* @param [] Extents - the count of elements along each dimension, dynamic_extent if known at runtime only
+*/
+template<class T, size_t... Extents> struct mdspan {
+    static_assert(sizeof...(Extents) != 0, "rank == 0");
+
+    using element_type = T;
+    using value_type = remove_const_t<T>;
+    using size_type = size_t;
+    using difference_type = ptrdiff_t;
+    using pointer = T*;
+    using reference = T&;
+    using const_reference = T const&;
+
+    constexpr _INLINE_VAR static size_t rank = sizeof...(Extents);
+
+    _NODISCARD constexpr static size_t static_extent(size_t const k) noexcept {
+        constexpr size_t extents[] = { Extents... };
+        return extents[k];
+    }
+
+    constexpr mdspan(T* const data, size_t const (&extents)[rank], ptrdiff_t const (&strides)[rank]) noexcept
+        : m_data(data), m_extents{}, m_strides{} {
+        for (size_t k = 0; k != rank; ++k) {
+            m_extents[k] = static_extent(k) != dynamic_extent ? static_extent(k) : extents[k];
+            m_strides[k] = strides[k];
+        }
+    }
+
+    /**
+    * all extents are static
+    */
+    constexpr mdspan(T* const data, ptrdiff_t const (&strides)[rank]) noexcept
+        : m_data(data), m_extents{}, m_strides{} {
+        static_assert(_all_static(), "dynamic extents have to be passed");
+        for (size_t k = 0; k != rank; ++k) {
+            m_extents[k] = static_extent(k);
+            m_strides[k] = strides[k];
+        }
+    }
+
+    /**
+    * row-major over a contiguous range
+    */
+    _NODISCARD constexpr static mdspan contiguous(T* const data, size_t const (&extents)[rank]) noexcept {
+        size_t es[rank] = {};
+        ptrdiff_t strides[rank] = {};
+        ptrdiff_t stride = 1;
+        for (size_t k = rank; k-- != 0;) {
+            es[k] = static_extent(k) != dynamic_extent ? static_extent(k) : extents[k];
+            strides[k] = stride;
+            stride *= ptrdiff_t(es[k]);
+        }
+        return mdspan(data, es, strides);
+    }
+
+    _NODISCARD constexpr static mdspan contiguous(T* const data) noexcept {
+        static_assert(_all_static(), "dynamic extents have to be passed");
+        size_t const extents[] = { Extents... };
+        return contiguous(data, extents);
+    }
+
+    template<class U, type_if<int, convertible_v<U*, T*>> = 0>
+    constexpr mdspan(mdspan<U, Extents...> const& other) noexcept
+        : mdspan(other.data(), other.m_extents, other.m_strides) {
+    }
+
+    _NODISCARD constexpr size_type extent(size_t const k) const noexcept {
+        return static_extent(k) != dynamic_extent ? static_extent(k) : m_extents[k];
+    }
+
+    _NODISCARD constexpr difference_type stride(size_t const k) const noexcept { return m_strides[k]; }
+
+    _NODISCARD constexpr size_type size() const noexcept {
+        size_type res = 1;
+        for (size_t k = 0; k != rank; ++k) res *= extent(k);
+        return res;
+    }
+
+    _NODISCARD constexpr bool empty() const noexcept { return size() == 0; }
+
+    _NODISCARD constexpr pointer data() const noexcept { return m_data; }
+
+    /**
+    * true if the innermost dimension is contiguous
+    */
+    _NODISCARD constexpr bool is_unit_stride() const noexcept { return m_strides[rank - 1] == 1; }
+
+    template<class... Indices, type_if<int, sizeof...(Indices) == rank> = 0>
+    _NODISCARD constexpr reference operator()(Indices const... indices) const noexcept {
+        size_t const is[] = { size_t(indices)... };
+        ptrdiff_t offset = 0;
+        for (size_t k = 0; k != rank; ++k) offset += ptrdiff_t(is[k]) * m_strides[k];
+        return m_data[offset];
+    }
+
+    template<size_t R = rank, type_if<int, R == 1> = 0>
+    _NODISCARD constexpr reference operator[](size_type const pos) const noexcept {
+        return m_data[ptrdiff_t(pos) * m_strides[0]];
+    }
+
+    template<class... Indices, type_if<int, sizeof...(Indices) == rank> = 0>
+    _NODISCARD constexpr reference at(Indices const... indices) const {
+        size_t const is[] = { size_t(indices)... };
+        for (size_t k = 0; k != rank; ++k) {
+            if (extent(k) <= is[k])
+                std::_Xout_of_range("mdspan::at");
+        }
+        return (*this)(indices...);
+    }
+
+    template<size_t R = rank, type_if<int, R == 2> = 0, size_t E1 = static_extent(R - 1)>
+    _NODISCARD constexpr mdspan<T, E1> row(size_type const i) const noexcept {
+        return { m_data + ptrdiff_t(i) * m_strides[0], { extent(1) }, { m_strides[1] } };
+    }
+
+    template<size_t R = rank, type_if<int, R == 2> = 0, size_t E0 = static_extent(0)>
+    _NODISCARD constexpr mdspan<T, E0> column(size_type const j) const noexcept {
+        return { m_data + ptrdiff_t(j) * m_strides[1], { extent(0) }, { m_strides[0] } };
+    }
+
+    /**
+    * the Rows x Cols block whose top left element is (i, j)
+    */
+    template<size_t Rows, size_t Cols, size_t R = rank, type_if<int, R == 2> = 0>
+    _NODISCARD constexpr mdspan<T, Rows, Cols> block(size_type const i, size_type const j) const noexcept {
+        return { m_data + ptrdiff_t(i) * m_strides[0] + ptrdiff_t(j) * m_strides[1], { Rows, Cols }, { m_strides[0], m_strides[1] } };
+    }
+
+    template<size_t R = rank, type_if<int, R == 2> = 0>
+    _NODISCARD constexpr mdspan<T, dynamic_extent, dynamic_extent> block(size_type const i, size_type const j, size_type const rows, size_type const cols) const noexcept {
+        return { m_data + ptrdiff_t(i) * m_strides[0] + ptrdiff_t(j) * m_strides[1], { rows, cols }, { m_strides[0], m_strides[1] } };
+    }
+
+    /**
+    * the same elements with the dimensions swapped, nothing is copied
+    */
+    template<size_t R = rank, type_if<int, R == 2> = 0, size_t E0 = static_extent(0), size_t E1 = static_extent(R - 1)>
+    _NODISCARD constexpr mdspan<T, E1, E0> transposed() const noexcept {
+        return { m_data, { extent(1), extent(0) }, { m_strides[1], m_strides[0] } };
+    }
+
+    /**
+    * visits the elements in row-major order; a contiguous innermost dimension is walked by pointer
+    */
+    template<class Proc>
+    constexpr type_if<size_type, util::invocable_v<Proc&, reference>> foreach(Proc&& proc) const {
+        _foreach<0>(m_data, proc, conditional<rank == 1>{});
+        return size();
+    }
+
+    template<class Proc>
+    constexpr type_if<size_type, util::invocable_v<Proc&, reference>> rforeach(Proc&& proc) const {
+        _rforeach<0>(m_data, proc, conditional<rank == 1>{});
+        return size();
+    }
+
+    constexpr size_type fill(value_type const& value) const {
+        return foreach([&value](reference elem) { elem = value; });
+    }
+
+protected:
+    pointer m_data;
+    size_t m_extents[rank];
+    ptrdiff_t m_strides[rank];
+
+    constexpr static bool _all_static() noexcept {
+        for (size_t k = 0; k != rank; ++k) {
+            if (static_extent(k) == dynamic_extent) return false;
+        }
+        return true;
+    }
+
+    template<size_t K, class Proc> constexpr void _foreach(pointer const p, Proc& proc, false_type) const {
+        for (size_t i = 0, n = extent(K); i != n; ++i) {
+            _foreach<K + 1>(p + ptrdiff_t(i) * m_strides[K], proc, conditional<K + 2 == rank>{});
+        }
+    }
+
+    template<size_t K, class Proc> constexpr void _foreach(pointer const p, Proc& proc, true_type) const {
+        size_t const n = extent(K);
+        if (m_strides[K] == 1) {
+            for (pointer i = p, end = p + n; i != end; ++i) util::invoke(proc, *i);
+        }
+        else {
+            for (size_t i = 0; i != n; ++i) util::invoke(proc, p[ptrdiff_t(i) * m_strides[K]]);
+        }
+    }
+
+    template<size_t K, class Proc> constexpr void _rforeach(pointer const p, Proc& proc, false_type) const {
+        for (size_t i = extent(K); i-- != 0;) {
+            _rforeach<K + 1>(p + ptrdiff_t(i) * m_strides[K], proc, conditional<K + 2 == rank>{});
+        }
+    }
+
+    template<size_t K, class Proc> constexpr void _rforeach(pointer const p, Proc& proc, true_type) const {
+        for (size_t i = extent(K); i-- != 0;) util::invoke(proc, p[ptrdiff_t(i) * m_strides[K]]);
+    }
+
+    template<class, size_t...> friend struct mdspan;
+};
+
+#endif // !__MDSPAN_HPP
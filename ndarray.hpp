@@ -0,0 +1,194 @@
+#ifndef __NDARRAY_HPP
+#define __NDARRAY_HPP 1
+
+#include "util.hpp"
+#include "object.hpp"
+#include "execution.hpp"
+#include "array.hpp"
+#include "mdspan.hpp"
+#include <utility>
+
+enum class layout : unsigned char {
+    row_major,
+    column_major
+};
+
+/**
+* multi-dimensional array with runtime extents over a single allocation
+* @param [] Rank - the count of dimensions
+*/
+template<class T, size_t Rank> struct ndarray {
+    static_assert(Rank != 0, "Rank == 0");
+
+    using value_type = T;
+    using size_type = size_t;
+    using difference_type = ptrdiff_t;
+    using pointer = T*;
+    using const_pointer = T const*;
+    using reference = T&;
+    using const_reference = T const&;
+
+    constexpr _INLINE_VAR static size_t rank = Rank;
+
+    ndarray() noexcept : m_elems(), m_extents{}, m_strides{} {
+    }
+
+    /**
+    * value-initializes the elements
+    */
+    template<class Int = type_if<int, is_constructible_v<T>>, Int = 0>
+    explicit ndarray(size_t const (&extents)[Rank], layout const order = layout::row_major)
+        : m_elems(_count(extents)), m_extents{}, m_strides{} {
+        _shape(extents, order);
+    }
+
+    template<class V = T, type_if<int, is_constructible_v<T, V const&>> = 0>
+    ndarray(size_t const (&extents)[Rank], V const& value, layout const order = layout::row_major)
+        : m_elems(_count(extents), value), m_extents{}, m_strides{} {
+        _shape(extents, order);
+    }
+
+    /**
+    * default-initializes the elements
+    */
+    template<class Int = type_if<int, is_constructible_v<T>>, Int = 0>
+    ndarray(arrays::for_overwrite_t, size_t const (&extents)[Rank], layout const order = layout::row_major)
+        : m_elems(arrays::for_overwrite, _count(extents)), m_extents{}, m_strides{} {
+        _shape(extents, order);
+    }
+
+    _NODISCARD size_type extent(size_t const k) const noexcept { return m_extents[k]; }
+
+    _NODISCARD difference_type stride(size_t const k) const noexcept { return m_strides[k]; }
+
+    _NODISCARD layout order() const noexcept {
+        return Rank == 1 || m_strides[Rank - 1] == 1 ? layout::row_major : layout::column_major;
+    }
+
+    _NODISCARD size_type size() const noexcept { return m_elems.size(); }
+
+    _NODISCARD bool empty() const noexcept { return m_elems.empty(); }
+
+    _NODISCARD pointer data() noexcept { return m_elems.data(); }
+
+    _NODISCARD const_pointer data() const noexcept { return m_elems.data(); }
+
+    template<class... Indices, type_if<int, sizeof...(Indices) == Rank> = 0>
+    _NODISCARD reference operator()(Indices const... indices) noexcept {
+        return m_elems.data()[_offset(indices...)];
+    }
+
+    template<class... Indices, type_if<int, sizeof...(Indices) == Rank> = 0>
+    _NODISCARD const_reference operator()(Indices const... indices) const noexcept {
+        return m_elems.data()[_offset(indices...)];
+    }
+
+    template<class... Indices, type_if<int, sizeof...(Indices) == Rank> = 0>
+    _NODISCARD reference at(Indices const... indices) {
+        _check(indices...);
+        return m_elems.data()[_offset(indices...)];
+    }
+
+    template<class... Indices, type_if<int, sizeof...(Indices) == Rank> = 0>
+    _NODISCARD const_reference at(Indices const... indices) const {
+        _check(indices...);
+        return m_elems.data()[_offset(indices...)];
+    }
+
+    _NODISCARD auto span() noexcept { return _span<T>(std::make_index_sequence<Rank>{}); }
+
+    _NODISCARD auto span() const noexcept { return _span<T const>(std::make_index_sequence<Rank>{}); }
+
+    /**
+    * the elements in storage order
+    */
+    _NODISCARD array<T> const& elements() const noexcept { return m_elems; }
+
+    /**
+    * visits the elements in storage order
+    */
+    template<class Proc, class... Args>
+    auto foreach(Proc&& proc, Args&&... args) -> decltype(std::declval<array<T>&>().foreach(static_cast<Proc&&>(proc), static_cast<Args&&>(args)...)) {
+        return m_elems.foreach(static_cast<Proc&&>(proc), static_cast<Args&&>(args)...);
+    }
+
+    template<class Proc, class... Args>
+    auto foreach(Proc&& proc, Args&&... args) const -> decltype(std::declval<array<T> const&>().foreach(static_cast<Proc&&>(proc), static_cast<Args&&>(args)...)) {
+        return m_elems.foreach(static_cast<Proc&&>(proc), static_cast<Args&&>(args)...);
+    }
+
+    template<class Proc, class... Args>
+    auto rforeach(Proc&& proc, Args&&... args) -> decltype(std::declval<array<T>&>().rforeach(static_cast<Proc&&>(proc), static_cast<Args&&>(args)...)) {
+        return m_elems.rforeach(static_cast<Proc&&>(proc), static_cast<Args&&>(args)...);
+    }
+
+    template<class Proc, class... Args>
+    auto rforeach(Proc&& proc, Args&&... args) const -> decltype(std::declval<array<T> const&>().rforeach(static_cast<Proc&&>(proc), static_cast<Args&&>(args)...)) {
+        return m_elems.rforeach(static_cast<Proc&&>(proc), static_cast<Args&&>(args)...);
+    }
+
+    /**
+    * @return an array of the same shape and layout
+    */
+    template<class Mapper, class... Args, class U = util::invoke_result_t<Mapper, const_reference, Args...>>
+    _NODISCARD type_if<ndarray<U, Rank>, !execution::is_policy_v<Mapper>, !is_same_v<void, U>> map(Mapper&& mapper, Args&&... args) const {
+        return { m_elems.map(static_cast<Mapper&&>(mapper), static_cast<Args&&>(args)...), m_extents, m_strides };
+    }
+
+    template<class Policy, class Mapper, class... Args, class U = util::invoke_result_t<Mapper&, const_reference, Args&...>>
+    _NODISCARD type_if<ndarray<U, Rank>, execution::is_policy_v<Policy>, !is_same_v<void, U>> map(Policy&& policy, Mapper&& mapper, Args&&... args) const {
+        return { m_elems.map(static_cast<Policy&&>(policy), static_cast<Mapper&&>(mapper), static_cast<Args&&>(args)...), m_extents, m_strides };
+    }
+
+protected:
+    array<T> m_elems;
+    size_t m_extents[Rank];
+    ptrdiff_t m_strides[Rank];
+
+    ndarray(array<T>&& elems, size_t const (&extents)[Rank], ptrdiff_t const (&strides)[Rank]) noexcept
+        : m_elems(static_cast<array<T>&&>(elems)), m_extents{}, m_strides{} {
+        for (size_t k = 0; k != Rank; ++k) {
+            m_extents[k] = extents[k];
+            m_strides[k] = strides[k];
+        }
+    }
+
+    _NODISCARD static size_t _count(size_t const (&extents)[Rank]) noexcept {
+        size_t res = 1;
+        for (size_t k = 0; k != Rank; ++k) res *= extents[k];
+        return res;
+    }
+
+    void _shape(size_t const (&extents)[Rank], layout const order) noexcept {
+        ptrdiff_t stride = 1;
+        for (size_t i = 0; i != Rank; ++i) {
+            size_t const k = order == layout::row_major ? Rank - 1 - i : i;
+            m_extents[k] = extents[k];
+            m_strides[k] = stride;
+            stride *= ptrdiff_t(extents[k]);
+        }
+    }
+
+    template<class... Indices> _NODISCARD ptrdiff_t _offset(Indices const... indices) const noexcept {
+        size_t const is[] = { size_t(indices)... };
+        ptrdiff_t res = 0;
+        for (size_t k = 0; k != Rank; ++k) res += ptrdiff_t(is[k]) * m_strides[k];
+        return res;
+    }
+
+    template<class... Indices> void _check(Indices const... indices) const {
+        size_t const is[] = { size_t(indices)... };
+        for (size_t k = 0; k != Rank; ++k) {
+            if (is[k] >= m_extents[k])
+                std::_Xout_of_range("ndarray::at");
+        }
+    }
+
+    template<class U, size_t... I> _NODISCARD mdspan<U, (I, dynamic_extent)...> _span(std::index_sequence<I...>) const noexcept {
+        return { const_cast<U*>(m_elems.data()), m_extents, m_strides };
+    }
+
+    template<class, size_t> friend struct ndarray;
+};
+
+#endif // !__NDARRAY_HPP
@@ -11,13 +11,69 @@ namespace std
 #include "util.hpp"
 #include "object.hpp"
 #include <memory>
+#include <limits>
+#include <cstring>
+#include <cstdint>
+
+#if _HAS_CXX20
+#include <bit>
+#endif // _HAS_CXX20
+
+/**
+* a value of T that optional<T> never holds, so that it marks emptiness in place of a flag and optional<T> is the size of T.
+* Specialize with enabled, null() and is_null(value) for T trivially destructible; optional_sentinel does so for a single value,
+* as optional_niche<size_t> : optional_sentinel<size_t, size_t(-1)> or optional_niche<int*> : optional_sentinel<int*, nullptr>,
+* and optional_float_niche for float and double. None is on by default. With a niche, optional<T> of T trivially copyable is
+* trivially copyable too, so arrays of it copy as bytes
+*/
+template<class T, class = void> struct optional_niche
+{
+    constexpr _INLINE_VAR static bool enabled = false;
+};
+
+template<class T, T Null> struct optional_sentinel
+{
+    constexpr _INLINE_VAR static bool enabled = true;
+
+    _NODISCARD constexpr static T null() noexcept { return Null; }
+
+    _NODISCARD constexpr static bool is_null(T const& value) noexcept { return value == Null; }
+};
+
+/**
+* float and double empty as the signaling NaN, told apart bitwise: arithmetic only yields quiet NaNs,
+* so a NaN computed still counts as a value. Opt in as template<> struct optional_niche<double> : optional_float_niche<double> {};
+*/
+template<class F> struct optional_float_niche
+{
+    static_assert(std::is_floating_point<F>::value && (sizeof(F) == 4 || sizeof(F) == 8), "F is not a 32 or 64 bit float");
+
+    constexpr _INLINE_VAR static bool enabled = true;
+
+    _NODISCARD constexpr static F null() noexcept { return std::numeric_limits<F>::signaling_NaN(); }
+
+    _NODISCARD constexpr static bool is_null(F const& value) noexcept { return _bits(value) == _bits(null()); }
+
+protected:
+    using _word = conditional<sizeof(F) == 4, uint32_t, uint64_t>;
+
+#if _HAS_CXX20
+    _NODISCARD constexpr static _word _bits(F const value) noexcept { return std::bit_cast<_word>(value); }
+#else
+    _NODISCARD static _word _bits(F const value) noexcept {
+        _word res;
+        std::memcpy(&res, &value, sizeof(F));
+        return res;
+    }
+#endif // _HAS_CXX20
+};
 
 template<class...> struct optional
 {
     constexpr operator bool() const noexcept { return false; }
 
 protected:
-    template<class T, bool = std::is_trivially_destructible<T>::value> struct _data_base
+    template<class T, bool = std::is_trivially_destructible<T>::value, bool = optional_niche<T>::enabled> struct _data_base
     {
         constexpr _data_base() noexcept
             : m_{}, m_present(false) {
@@ -27,6 +83,12 @@ protected:
             : m_value{ static_cast<V&&>(value) }, m_present(true) {
         }
 
+        _NODISCARD constexpr bool _present() const noexcept { return m_present; }
+
+        void _set_present() noexcept {
+            m_present = true;
+        }
+
         void _reset() noexcept {
             m_present = false;
         }
@@ -38,7 +100,7 @@ protected:
         bool m_present;
     };
 
-    template<class T> struct _data_base<T, false>
+    template<class T> struct _data_base<T, false, false>
     {
         constexpr _data_base() noexcept
             : m_{}, m_present(false) {
@@ -49,7 +111,13 @@ protected:
         }
 
         ~_data_base() noexcept {
-            objects::destroy(m_value);
+            if (m_present) objects::destroy(m_value);
+        }
+
+        _NODISCARD constexpr bool _present() const noexcept { return m_present; }
+
+        void _set_present() noexcept {
+            m_present = true;
         }
 
         void _reset() noexcept {
@@ -66,6 +134,40 @@ protected:
         bool m_present;
     };
 
+    /**
+    * no flag: empty while m_value is the niche's null
+    */
+    template<class T> struct _data_base<T, true, true>
+    {
+        using _niche = optional_niche<T>;
+
+        constexpr _data_base() noexcept
+            : m_value(_niche::null()) {
+        }
+
+        template<class V> constexpr explicit _data_base(V&& value) noexcept(is_nothrow_constructible_v<T, V&&>)
+            : m_value{ static_cast<V&&>(value) } {
+            _STL_ASSERT(!_niche::is_null(m_value), "optional<T> of the null of optional_niche<T>");
+        }
+
+        _NODISCARD constexpr bool _present() const noexcept { return !_niche::is_null(m_value); }
+
+        void _set_present() noexcept {
+            _STL_ASSERT(!_niche::is_null(m_value), "optional<T> of the null of optional_niche<T>");
+        }
+
+        void _reset() noexcept {
+            m_value = _niche::null();
+        }
+
+        T m_value;
+    };
+
+    template<class T> struct _data_base<T, false, true>
+    {
+        static_assert(std::is_trivially_destructible<T>::value, "optional_niche<T> with T not trivially destructible");
+    };
+
     template<class T> struct _base : _data_base<T>
     {
         using _data_base<T>::_data_base;
@@ -80,14 +182,8 @@ protected:
             : _data_base(static_cast<V&&>(value)) {
         }
 
-        constexpr _base(_base&& o) noexcept
-            : _data_base() {
-            objects::swap_bytes(*this, o);
-        }
-
         using _data_base::_reset;
-
-        _NODISCARD constexpr bool _present() const noexcept { return m_present; }
+        using _data_base::_present;
 
         _NODISCARD constexpr T& _ref() noexcept { return m_value; }
         _NODISCARD constexpr T const& _ref() const noexcept { return m_value; }
@@ -97,7 +193,7 @@ protected:
 
         template<class V> void _construct(V&& value) noexcept(is_nothrow_constructible_v<T, V&&>) {
             new(&m_value) T(static_cast<V&&>(value));
-            m_present = true;
+            _data_base::_set_present();
         }
 
         template<class V> constexpr void _assign(V&& value, false_type) noexcept(is_nothrow_constructible_v<T, V&&>) {
@@ -106,8 +202,9 @@ protected:
         }
 
         template<class V> constexpr void _assign(V&& value, true_type) noexcept(is_nothrow_constructible_v<T, V&&>&& is_nothrow_assignable_v<T, V&&>) {
-            if (m_present) {
+            if (_present()) {
                 m_value = static_cast<V&&>(value);
+                _data_base::_set_present();
             } else {
                 _assign(static_cast<V&&>(value), false_type);
             }
@@ -117,19 +214,70 @@ protected:
             _assign(static_cast<V&&>(value), is_assignable<T&, V&&>);
         }
 
-        using _data_base::m_present;
         using _data_base::m_value;
     };
 
+    struct _nocopy {};
+
+    /**
+    * copies and moves; trivial where T has a niche and is trivially copyable
+    */
+    template<class T, bool = optional_niche<T>::enabled && std::is_trivially_copyable<T>::value> struct _copy_base : _base<T>
+    {
+        using _base<T>::_base;
+
+        constexpr _copy_base() noexcept
+            : _base<T>() {
+        }
+
+        _copy_base(conditional<is_copy_constructible_v<T>, _copy_base, _nocopy> const& other) noexcept(is_nothrow_constructible_v<T, T const&>)
+            : _base<T>() {
+            if (other._present()) this->_construct(other.m_value);
+        }
+
+        _copy_base(_copy_base&& other) noexcept
+            : _base<T>() {
+            objects::swap_bytes(*this, other);
+        }
+
+        _copy_base& operator=(conditional<is_copy_constructible_v<T>, _copy_base, _nocopy> const& right)
+            noexcept(is_nothrow_constructible_v<T, T const&> && is_nothrow_assignable_v<T, T const&>) {
+            if (this != std::addressof(right))
+            {
+                if (right._present()) this->_assign(right.m_value);
+                else this->_reset();
+            }
+            return *this;
+        }
+
+        _copy_base& operator=(_copy_base&& right) noexcept {
+            if (this != std::addressof(right))
+            {
+                this->_reset();
+                objects::swap_bytes(*this, right);
+            }
+            return *this;
+        }
+    };
+
+    template<class T> struct _copy_base<T, true> : _base<T>
+    {
+        using _base<T>::_base;
+
+        constexpr _copy_base() noexcept
+            : _base<T>() {
+        }
+    };
+
     template<class...> friend struct optional;
 };
 
 using nullopt_t = optional<>;
 _INLINE_VAR constexpr nullopt_t nullopt;
 
-template<class T> struct optional<T> : protected optional<>::_base<T>
+template<class T> struct optional<T> : protected optional<>::_copy_base<T>
 {
-    using _base = optional<>::_base<T>;
+    using _base = optional<>::_copy_base<T>;
     using value_type = T;
 
     constexpr optional() noexcept : _base() {}
@@ -138,7 +286,7 @@ template<class T> struct optional<T> : protected optional<>::_base<T>
 
     constexpr optional& operator=(nullopt_t) noexcept { reset(); return *this; }
 
-    template<class U, type_if<int, is_constructible_v<T, U&&>> = 0>
+    template<class U, type_if<int, !is_same_v<remove_cvref_t<U>, optional>, is_constructible_v<T, U&&>> = 0>
     constexpr optional(U&& value) noexcept(noexcept(_base(static_cast<U&&>(value))))
         : _base(static_cast<U&&>(value)) {
     }
@@ -149,9 +297,7 @@ template<class T> struct optional<T> : protected optional<>::_base<T>
         ptr.reset();
     }
 
-    constexpr optional(type_if<optional, is_copy_constructible_v<T>> const& other) noexcept(noexcept(_base::_construct(*other))) {
-        if (other) _base::_construct(*other);
-    }
+    optional(optional const&) = default;
 
     template<class U, type_if<int, !std::is_reference<U>::value, is_constructible_v<T, U const&>> = 0>
     constexpr optional(optional<U> const& other) noexcept(noexcept(_base::_construct(*other))) {
@@ -168,18 +314,11 @@ template<class T> struct optional<T> : protected optional<>::_base<T>
         return *this;
     }
 
-    constexpr optional(optional&& other) noexcept(noexcept(_base(static_cast<_base&&>(other))))
-        : _base(static_cast<_base&&>(other)) {
-    }
+    optional(optional&&) = default;
 
-    constexpr optional& operator=(optional&& right) noexcept {
-        if (this != std::addressof(right))
-        {
-            reset();
-            objects::swap_bytes(*this, right);
-        }
-        return *this;
-    }
+    optional& operator=(optional const&) = default;
+
+    optional& operator=(optional&&) = default;
 
     template<class U, type_if<int, !std::is_reference<U>::value, is_constructible_v<T, U&&>> = 0>
     constexpr optional(optional<U>&& other) noexcept(noexcept(_base::_construct(static_cast<U&&>(*other)))) {
@@ -251,16 +390,21 @@ template<class T> struct optional<T> : protected optional<>::_base<T>
     }
 
 protected:
-    using _base::m_present;
-
     template<class...> friend struct optional;
 
 #if _HAS_CXX17
 public:
-    constexpr operator std::optional<T>& () & noexcept { return reinterpret_cast<std::optional<T>&>(*this); }
-    constexpr operator std::optional<T> const& () const& noexcept { return reinterpret_cast<std::optional<T> const&>(*this); }
-    constexpr operator std::optional<T> && () && noexcept { return reinterpret_cast<std::optional<T>&&>(*this); }
-    constexpr operator std::optional<T> const&& () const&& noexcept { return reinterpret_cast<std::optional<T> const&&>(*this); }
+    /**
+    * layout compatible with std::optional<T> unless T has an optional_niche
+    */
+    template<class U, type_if<int, is_same_v<U, T>, !optional_niche<U>::enabled> = 0>
+    constexpr operator std::optional<U>& () & noexcept { return reinterpret_cast<std::optional<T>&>(*this); }
+    template<class U, type_if<int, is_same_v<U, T>, !optional_niche<U>::enabled> = 0>
+    constexpr operator std::optional<U> const& () const& noexcept { return reinterpret_cast<std::optional<T> const&>(*this); }
+    template<class U, type_if<int, is_same_v<U, T>, !optional_niche<U>::enabled> = 0>
+    constexpr operator std::optional<U> && () && noexcept { return reinterpret_cast<std::optional<T>&&>(*this); }
+    template<class U, type_if<int, is_same_v<U, T>, !optional_niche<U>::enabled> = 0>
+    constexpr operator std::optional<U> const&& () const&& noexcept { return reinterpret_cast<std::optional<T> const&&>(*this); }
 #endif // _HAS_CXX17
 };
 
@@ -0,0 +1,239 @@
+#ifndef __OPTIONAL_ARRAY_HPP
+#define __OPTIONAL_ARRAY_HPP 1
+
+#include "util.hpp"
+#include "object.hpp"
+#include "array.hpp"
+#include "optional.hpp"
+#include "algorithm.hpp"
+#include "bit_array.hpp"
+#include <utility>
+
+/**
+* a nullable column: the values contiguous in an array<T> and their presence in a bitmap apart, so that the kernels over
+* values run a word of presence bits at a time with no branch per element and vectorize. Absent slots hold T()
+*/
+template<class T> struct optional_array {
+    using value_type = T;
+    using size_type = size_t;
+    using reference = T&;
+    using const_reference = T const&;
+
+    optional_array() noexcept : m_values(), m_words(), m_size(0) {}
+
+    /**
+    * n absent values
+    */
+    explicit optional_array(size_type const n) : m_values(n), m_words(bits::words(n)), m_size(n) {}
+
+    explicit optional_array(array<optional<T>> const& dense) : m_values(dense.size()), m_words(bits::words(dense.size())), m_size(dense.size()) {
+        optional<T> const* const data = dense.data();
+        for (size_t i = 0; i != m_size; ++i) {
+            if (!data[i]) continue;
+            m_values.data()[i] = *data[i];
+            m_words.data()[i / bits::word_bits] |= bits::word(1) << (i % bits::word_bits);
+        }
+    }
+
+    optional_array(optional_array const& other) : m_values(other.m_values), m_words(other.m_words), m_size(other.m_size) {}
+
+    optional_array(optional_array&& other) noexcept
+        : m_values(static_cast<array<T>&&>(other.m_values)), m_words(static_cast<array<bits::word>&&>(other.m_words)), m_size(other.m_size) {
+        other.m_size = 0;
+    }
+
+    optional_array& operator=(optional_array other) noexcept {
+        swap(other);
+        return *this;
+    }
+
+    void swap(optional_array& other) noexcept {
+        m_values.swap(other.m_values);
+        m_words.swap(other.m_words);
+        std::swap(m_size, other.m_size);
+    }
+
+    _NODISCARD size_type size() const noexcept { return m_size; }
+
+    _NODISCARD bool empty() const noexcept { return m_size == 0; }
+
+    /**
+    * the count of present values
+    */
+    _NODISCARD size_type count() const noexcept { return bits::count(m_words.data(), bits::words(m_size)); }
+
+    _NODISCARD bool has_value(size_type const pos) const noexcept {
+        return (m_words.data()[pos / bits::word_bits] >> (pos % bits::word_bits)) & 1;
+    }
+
+    /**
+    * every slot, T() where absent
+    */
+    _NODISCARD T* values() noexcept { return m_values.data(); }
+
+    _NODISCARD T const* values() const noexcept { return m_values.data(); }
+
+    /**
+    * the presence bits, bits::words(size()) of them
+    */
+    _NODISCARD bits::word const* presence() const noexcept { return m_words.data(); }
+
+    /**
+    * @param [] pos - present
+    */
+    _NODISCARD reference operator[](size_type const pos) noexcept { return m_values.data()[pos]; }
+
+    _NODISCARD const_reference operator[](size_type const pos) const noexcept { return m_values.data()[pos]; }
+
+    _NODISCARD reference at(size_type const pos) {
+        if (pos >= m_size || !has_value(pos))
+            std::_Xout_of_range("optional_array::at");
+        return m_values.data()[pos];
+    }
+
+    _NODISCARD const_reference at(size_type const pos) const {
+        if (pos >= m_size || !has_value(pos))
+            std::_Xout_of_range("optional_array::at");
+        return m_values.data()[pos];
+    }
+
+    _NODISCARD optional<T> get(size_type const pos) const {
+        return has_value(pos) ? optional<T>(m_values.data()[pos]) : optional<T>();
+    }
+
+    _NODISCARD const_reference or_default(size_type const pos, const_reference deflt) const noexcept {
+        return has_value(pos) ? m_values.data()[pos] : deflt;
+    }
+
+    template<class V, type_if<int, is_assignable_v<T&, V&&>> = 0>
+    reference set(size_type const pos, V&& value) {
+        m_words.data()[pos / bits::word_bits] |= bits::word(1) << (pos % bits::word_bits);
+        return m_values.data()[pos] = static_cast<V&&>(value);
+    }
+
+    void reset(size_type const pos) {
+        m_words.data()[pos / bits::word_bits] &= ~(bits::word(1) << (pos % bits::word_bits));
+        m_values.data()[pos] = T();
+    }
+
+    /**
+    * the values with deflt where absent
+    */
+    _NODISCARD array<T> or_default(const_reference deflt) const {
+        array<T> res{ arrays::for_overwrite, m_size };
+        _select(res.data(), deflt);
+        return res;
+    }
+
+    /**
+    * writes deflt into the absent slots and marks every slot present
+    */
+    optional_array& fill_absent(const_reference deflt) {
+        _select(m_values.data(), deflt);
+        size_t const n = bits::words(m_size);
+        for (size_t w = 0; w != n; ++w) m_words.data()[w] = ~bits::word(0);
+        if (n) m_words.data()[n - 1] = bits::tail_mask(m_size);
+        return *this;
+    }
+
+    /**
+    * folds the present values in order
+    */
+    template<class Init, class Op>
+    type_if<Init, convertible_v<util::invoke_result_t<Op&, Init&&, T const&>, Init>> reduce(Init init, Op&& op) const {
+        foreach([&init, &op](size_t, T const& value) { init = util::invoke(op, static_cast<Init&&>(init), value); });
+        return init;
+    }
+
+    /**
+    * the sum of the present values; the absent are masked to T() rather than skipped, so that the loop vectorizes
+    */
+    _NODISCARD T sum() const noexcept {
+        T res = T();
+        size_t const n = m_size / bits::word_bits;
+        T const* const values = m_values.data();
+        for (size_t w = 0; w != n; ++w) res += _masked_sum(values + w * bits::word_bits, m_words.data()[w], bits::word_bits);
+        if (m_size % bits::word_bits) res += _masked_sum(values + n * bits::word_bits, m_words.data()[n], m_size % bits::word_bits);
+        return res;
+    }
+
+    /**
+    * the least present value, empty if none
+    */
+    template<class Comp = default_comporator>
+    _NODISCARD type_if<optional<T>, objects::is_ordering_v<util::invoke_result_t<Comp&, T const&, T const&>>> min(Comp&& comp = Comp{}) const {
+        T const* res = nullptr;
+        foreach([&res, &comp](size_t, T const& value) { if (!res || util::invoke(comp, value, *res) < 0) res = &value; });
+        return res ? optional<T>(*res) : optional<T>();
+    }
+
+    template<class Comp = default_comporator>
+    _NODISCARD type_if<optional<T>, objects::is_ordering_v<util::invoke_result_t<Comp&, T const&, T const&>>> max(Comp&& comp = Comp{}) const {
+        T const* res = nullptr;
+        foreach([&res, &comp](size_t, T const& value) { if (!res || util::invoke(comp, *res, value) < 0) res = &value; });
+        return res ? optional<T>(*res) : optional<T>();
+    }
+
+    /**
+    * visits the present values in index order
+    * @param [] proc - invoked as proc(index, value)
+    */
+    template<class Proc>
+    type_if<size_type, util::invocable_v<Proc&, size_t, reference>> foreach(Proc&& proc) {
+        return _foreach(*this, proc);
+    }
+
+    template<class Proc>
+    type_if<size_type, util::invocable_v<Proc&, size_t, const_reference>> foreach(Proc&& proc) const {
+        return _foreach(*this, proc);
+    }
+
+    /**
+    * the interleaved form
+    */
+    _NODISCARD array<optional<T>> to_array() const {
+        array<optional<T>> res(m_size);
+        optional<T>* const data = res.data();
+        foreach([data](size_t const pos, T const& value) { data[pos] = optional<T>(value); });
+        return res;
+    }
+
+protected:
+    array<T> m_values;
+    array<bits::word> m_words;
+    size_t m_size;
+
+    /**
+    * out[i] = present ? value : deflt, a select per element
+    */
+    void _select(T* const out, const_reference deflt) const {
+        T const* const values = m_values.data();
+        bits::word const* const words = m_words.data();
+        for (size_t i = 0; i != m_size; ++i) {
+            bool const present = (words[i / bits::word_bits] >> (i % bits::word_bits)) & 1;
+            out[i] = present ? values[i] : deflt;
+        }
+    }
+
+    _NODISCARD static T _masked_sum(T const* const values, bits::word const mask, size_t const n) noexcept {
+        T res = T();
+        for (size_t i = 0; i != n; ++i) res += (mask >> i) & 1 ? values[i] : T();
+        return res;
+    }
+
+    template<class Self, class Proc> static size_t _foreach(Self& self, Proc& proc) {
+        size_t const n = bits::words(self.m_size);
+        bits::word const* const words = self.m_words.data();
+        auto* const values = self.m_values.data();
+        size_t res = 0;
+        for (size_t w = 0; w != n; ++w) {
+            for (bits::word set = words[w]; set; set &= set - 1, ++res) {
+                size_t const pos = w * bits::word_bits + size_t(algorithms::countr_zero(set));
+                util::invoke(proc, pos, values[pos]);
+            }
+        }
+        return res;
+    }
+};
+
+#endif // !__OPTIONAL_ARRAY_HPP
@@ -0,0 +1,201 @@
+#ifndef __RING_BUFFER_HPP
+#define __RING_BUFFER_HPP 1
+
+#include "util.hpp"
+#include "object.hpp"
+#include "array.hpp"
+#include <cstring>
+#include <type_traits>
+
+/**
+* fixed-capacity FIFO over an array<T, N>: positions are free-running counters masked into the array, nothing is allocated.
+* Popped elements stay in their slot until overwritten.
+* @param [] N - the capacity, a power of two
+*/
+template<class T, size_t N> struct ring_buffer {
+    static_assert(N != 0 && (N & (N - 1)) == 0, "N is not a power of two");
+
+    using value_type = T;
+    using size_type = size_t;
+    using reference = T&;
+    using const_reference = T const&;
+
+    constexpr ring_buffer() noexcept(is_nothrow_constructible_v<T>) : m_elems(), m_head(0), m_tail(0) {}
+
+    _NODISCARD constexpr static size_type capacity() noexcept { return N; }
+
+    _NODISCARD constexpr size_type size() const noexcept { return m_tail - m_head; }
+
+    _NODISCARD constexpr bool empty() const noexcept { return m_tail == m_head; }
+
+    _NODISCARD constexpr bool full() const noexcept { return size() == N; }
+
+    /**
+    * the oldest element
+    */
+    _NODISCARD constexpr reference front() noexcept { return m_elems[m_head & _mask]; }
+    _NODISCARD constexpr const_reference front() const noexcept { return m_elems[m_head & _mask]; }
+
+    /**
+    * the newest element
+    */
+    _NODISCARD constexpr reference back() noexcept { return m_elems[(m_tail - 1) & _mask]; }
+    _NODISCARD constexpr const_reference back() const noexcept { return m_elems[(m_tail - 1) & _mask]; }
+
+    /**
+    * @param [] pos - counted from the oldest element
+    */
+    _NODISCARD constexpr reference operator[](size_type const pos) noexcept { return m_elems[(m_head + pos) & _mask]; }
+    _NODISCARD constexpr const_reference operator[](size_type const pos) const noexcept { return m_elems[(m_head + pos) & _mask]; }
+
+    _NODISCARD constexpr reference at(size_type const pos) {
+        _check(pos);
+        return (*this)[pos];
+    }
+
+    _NODISCARD constexpr const_reference at(size_type const pos) const {
+        _check(pos);
+        return (*this)[pos];
+    }
+
+    /**
+    * @return false if full
+    */
+    template<class V, type_if<int, is_assignable_v<T&, V&&>> = 0>
+    constexpr bool push(V&& value) noexcept(std::is_nothrow_assignable<T&, V&&>::value) {
+        if (full()) return false;
+        m_elems[m_tail++ & _mask] = static_cast<V&&>(value);
+        return true;
+    }
+
+    /**
+    * drops the oldest element when full, as a sliding window does
+    */
+    template<class V, type_if<int, is_assignable_v<T&, V&&>> = 0>
+    constexpr void push_overwrite(V&& value) noexcept(std::is_nothrow_assignable<T&, V&&>::value) {
+        if (full()) ++m_head;
+        m_elems[m_tail++ & _mask] = static_cast<V&&>(value);
+    }
+
+    /**
+    * @return false if empty
+    */
+    constexpr bool pop(T& out) noexcept(std::is_nothrow_move_assignable<T>::value) {
+        if (empty()) return false;
+        out = static_cast<T&&>(m_elems[m_head++ & _mask]);
+        return true;
+    }
+
+    /**
+    * pushes as many of the n elements as fit, in at most two contiguous copies
+    * @return the count pushed
+    */
+    size_type push(T const* const data, size_type const n) noexcept(std::is_nothrow_copy_assignable<T>::value) {
+        size_t const count = n < N - size() ? n : N - size();
+        size_t const pos = m_tail & _mask;
+        size_t const first = count < N - pos ? count : N - pos;
+        _copy(m_elems.data() + pos, data, first, std::is_trivially_copyable<T>{});
+        _copy(m_elems.data(), data + first, count - first, std::is_trivially_copyable<T>{});
+        m_tail += count;
+        return count;
+    }
+
+    /**
+    * pops up to n elements into out, in at most two contiguous copies
+    * @return the count popped
+    */
+    size_type pop(T* const out, size_type const n) noexcept(std::is_nothrow_move_assignable<T>::value) {
+        size_t const count = n < size() ? n : size();
+        size_t const pos = m_head & _mask;
+        size_t const first = count < N - pos ? count : N - pos;
+        _move(out, m_elems.data() + pos, first, std::is_trivially_copyable<T>{});
+        _move(out + first, m_elems.data(), count - first, std::is_trivially_copyable<T>{});
+        m_head += count;
+        return count;
+    }
+
+    /**
+    * discards up to n of the oldest elements
+    * @return the count discarded
+    */
+    constexpr size_type drop(size_type const n) noexcept {
+        size_t const count = n < size() ? n : size();
+        m_head += count;
+        return count;
+    }
+
+    constexpr void clear() noexcept { m_head = m_tail; }
+
+    /**
+    * visits the elements from the oldest, as the two contiguous runs they form
+    */
+    template<class Proc, class... Args>
+    constexpr type_if<size_type, util::invocable_v<Proc, reference, Args...>> foreach(Proc&& proc, Args&&... args) {
+        return _foreach(*this, proc, args...);
+    }
+
+    template<class Proc, class... Args>
+    constexpr type_if<size_type, util::invocable_v<Proc, const_reference, Args...>> foreach(Proc&& proc, Args&&... args) const {
+        return _foreach(*this, proc, args...);
+    }
+
+    template<class Proc, class... Args>
+    constexpr type_if<size_type, util::invocable_v<Proc, reference, Args...>> rforeach(Proc&& proc, Args&&... args) {
+        return _rforeach(*this, proc, args...);
+    }
+
+    template<class Proc, class... Args>
+    constexpr type_if<size_type, util::invocable_v<Proc, const_reference, Args...>> rforeach(Proc&& proc, Args&&... args) const {
+        return _rforeach(*this, proc, args...);
+    }
+
+protected:
+    constexpr _INLINE_VAR static size_t _mask = N - 1;
+
+    array<T, N> m_elems;
+    size_t m_head;
+    size_t m_tail;
+
+    constexpr void _check(size_type const pos) const {
+        if (pos >= size())
+            std::_Xout_of_range("ring_buffer::at");
+    }
+
+    static void _copy(T* const dst, T const* const src, size_t const n, true_type) noexcept {
+        if (n) std::memcpy(dst, src, n * sizeof(T));
+    }
+
+    static void _copy(T* const dst, T const* const src, size_t const n, false_type) noexcept(std::is_nothrow_copy_assignable<T>::value) {
+        for (size_t i = 0; i != n; ++i) dst[i] = src[i];
+    }
+
+    static void _move(T* const dst, T* const src, size_t const n, true_type) noexcept {
+        if (n) std::memcpy(dst, src, n * sizeof(T));
+    }
+
+    static void _move(T* const dst, T* const src, size_t const n, false_type) noexcept(std::is_nothrow_move_assignable<T>::value) {
+        for (size_t i = 0; i != n; ++i) dst[i] = static_cast<T&&>(src[i]);
+    }
+
+    template<class Self, class Proc, class... Args> constexpr static size_t _foreach(Self& self, Proc& proc, Args&... args) {
+        size_t const n = self.size();
+        size_t const pos = self.m_head & _mask;
+        size_t const first = n < N - pos ? n : N - pos;
+        auto const data = self.m_elems.data();
+        for (size_t i = pos; i != pos + first; ++i) util::invoke(proc, data[i], args...);
+        for (size_t i = 0; i != n - first; ++i) util::invoke(proc, data[i], args...);
+        return n;
+    }
+
+    template<class Self, class Proc, class... Args> constexpr static size_t _rforeach(Self& self, Proc& proc, Args&... args) {
+        size_t const n = self.size();
+        size_t const pos = self.m_head & _mask;
+        size_t const first = n < N - pos ? n : N - pos;
+        auto const data = self.m_elems.data();
+        for (size_t i = n - first; i != 0; ) util::invoke(proc, data[--i], args...);
+        for (size_t i = pos + first; i != pos; ) util::invoke(proc, data[--i], args...);
+        return n;
+    }
+};
+
+#endif // !__RING_BUFFER_HPP
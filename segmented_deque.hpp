@@ -0,0 +1,357 @@
+#ifndef __SEGMENTED_DEQUE_HPP
+#define __SEGMENTED_DEQUE_HPP 1
+
+#include "util.hpp"
+#include "object.hpp"
+#include <cstring>
+#include <iterator>
+#include <new>
+
+/**
+* double-ended queue over fixed-size chunks of N contiguous elements, indexed by a map of chunk pointers:
+* pushes and pops at both ends are O(1) and never move an element, so references stay valid until the element is popped.
+* Emptied chunks are kept in a pool and reused before anything is allocated
+* @param [] N - elements per chunk, about 4 KiB of them by default
+*/
+template<class T, size_t N = (sizeof(T) < 256 ? 4096 / sizeof(T) : 16)> struct segmented_deque {
+    static_assert(N != 0, "N == 0");
+
+    using value_type = T;
+    using size_type = size_t;
+    using difference_type = ptrdiff_t;
+    using reference = T&;
+    using const_reference = T const&;
+
+    constexpr _INLINE_VAR static size_t chunk_size = N;
+
+    template<bool Const> struct _iterator {
+        using value_type = T;
+        using difference_type = ptrdiff_t;
+        using pointer = conditional<Const, T const*, T*>;
+        using reference = conditional<Const, T const&, T&>;
+        using iterator_category = std::random_access_iterator_tag;
+
+        using owner = conditional<Const, segmented_deque const, segmented_deque>;
+
+        constexpr _iterator() noexcept : m_owner(nullptr), m_pos(0) {}
+
+        constexpr _iterator(owner* const deque, size_t const pos) noexcept : m_owner(deque), m_pos(pos) {}
+
+        template<bool C = Const, type_if<int, C> = 0>
+        constexpr _iterator(_iterator<false> const& other) noexcept : m_owner(other.m_owner), m_pos(other.m_pos) {}
+
+        _NODISCARD reference operator*() const noexcept { return (*m_owner)[m_pos]; }
+
+        _NODISCARD pointer operator->() const noexcept { return &(*m_owner)[m_pos]; }
+
+        _NODISCARD reference operator[](difference_type const n) const noexcept { return (*m_owner)[size_t(ptrdiff_t(m_pos) + n)]; }
+
+        _iterator& operator++() noexcept {
+            ++m_pos;
+            return *this;
+        }
+
+        _iterator operator++(int) noexcept { return { m_owner, m_pos++ }; }
+
+        _iterator& operator--() noexcept {
+            --m_pos;
+            return *this;
+        }
+
+        _iterator operator--(int) noexcept { return { m_owner, m_pos-- }; }
+
+        _iterator& operator+=(difference_type const n) noexcept {
+            m_pos = size_t(ptrdiff_t(m_pos) + n);
+            return *this;
+        }
+
+        _iterator& operator-=(difference_type const n) noexcept { return *this += -n; }
+
+        _NODISCARD _iterator operator+(difference_type const n) const noexcept { return { m_owner, size_t(ptrdiff_t(m_pos) + n) }; }
+
+        _NODISCARD _iterator operator-(difference_type const n) const noexcept { return { m_owner, size_t(ptrdiff_t(m_pos) - n) }; }
+
+        template<bool C> _NODISCARD difference_type operator-(_iterator<C> const& other) const noexcept { return ptrdiff_t(m_pos) - ptrdiff_t(other.m_pos); }
+
+        template<bool C> _NODISCARD bool operator==(_iterator<C> const& other) const noexcept { return m_pos == other.m_pos; }
+
+        template<bool C> _NODISCARD bool operator!=(_iterator<C> const& other) const noexcept { return m_pos != other.m_pos; }
+
+        template<bool C> _NODISCARD bool operator<(_iterator<C> const& other) const noexcept { return m_pos < other.m_pos; }
+
+        template<bool C> _NODISCARD bool operator>(_iterator<C> const& other) const noexcept { return m_pos > other.m_pos; }
+
+        template<bool C> _NODISCARD bool operator<=(_iterator<C> const& other) const noexcept { return m_pos <= other.m_pos; }
+
+        template<bool C> _NODISCARD bool operator>=(_iterator<C> const& other) const noexcept { return m_pos >= other.m_pos; }
+
+        _NODISCARD friend _iterator operator+(difference_type const n, _iterator const& it) noexcept { return it + n; }
+
+    protected:
+        owner* m_owner;
+        size_t m_pos;
+
+        template<bool> friend struct _iterator;
+    };
+
+    using iterator = _iterator<false>;
+    using const_iterator = _iterator<true>;
+
+    segmented_deque() noexcept : m_map(nullptr), m_map_size(0), m_offset(0), m_size(0), m_pool(nullptr) {}
+
+    segmented_deque(segmented_deque const& other) : segmented_deque() {
+        other.foreach([this](T const& value) { emplace_back(value); });
+    }
+
+    segmented_deque(segmented_deque&& other) noexcept : segmented_deque() {
+        swap(other);
+    }
+
+    segmented_deque& operator=(segmented_deque other) noexcept {
+        swap(other);
+        return *this;
+    }
+
+    ~segmented_deque() noexcept {
+        clear();
+        for (size_t c = 0; c != m_map_size; ++c) delete m_map[c];
+        shrink_to_fit();
+        delete[] m_map;
+    }
+
+    void swap(segmented_deque& other) noexcept {
+        std::swap(m_map, other.m_map);
+        std::swap(m_map_size, other.m_map_size);
+        std::swap(m_offset, other.m_offset);
+        std::swap(m_size, other.m_size);
+        std::swap(m_pool, other.m_pool);
+    }
+
+    _NODISCARD size_type size() const noexcept { return m_size; }
+
+    _NODISCARD bool empty() const noexcept { return m_size == 0; }
+
+    _NODISCARD iterator begin() noexcept { return { this, 0 }; }
+    _NODISCARD const_iterator begin() const noexcept { return { this, 0 }; }
+
+    _NODISCARD iterator end() noexcept { return { this, m_size }; }
+    _NODISCARD const_iterator end() const noexcept { return { this, m_size }; }
+
+    _NODISCARD reference operator[](size_type const pos) noexcept { return _at(m_offset + pos); }
+
+    _NODISCARD const_reference operator[](size_type const pos) const noexcept { return _at(m_offset + pos); }
+
+    _NODISCARD reference at(size_type const pos) {
+        _check(pos);
+        return (*this)[pos];
+    }
+
+    _NODISCARD const_reference at(size_type const pos) const {
+        _check(pos);
+        return (*this)[pos];
+    }
+
+    _NODISCARD reference front() noexcept { return _at(m_offset); }
+    _NODISCARD const_reference front() const noexcept { return _at(m_offset); }
+
+    _NODISCARD reference back() noexcept { return _at(m_offset + m_size - 1); }
+    _NODISCARD const_reference back() const noexcept { return _at(m_offset + m_size - 1); }
+
+    template<class... Args, type_if<int, is_constructible_v<T, Args&&...>> = 0>
+    reference emplace_back(Args&&... args) {
+        size_t const pos = m_offset + m_size;
+        if (pos / N == m_map_size) _grow_map();
+        T* const slot = _slot(m_offset + m_size);
+        new(slot) T(static_cast<Args&&>(args)...);
+        ++m_size;
+        return *slot;
+    }
+
+    template<class... Args, type_if<int, is_constructible_v<T, Args&&...>> = 0>
+    reference emplace_front(Args&&... args) {
+        if (m_offset == 0) _grow_map();
+        T* const slot = _slot(m_offset - 1);
+        new(slot) T(static_cast<Args&&>(args)...);
+        --m_offset;
+        ++m_size;
+        return *slot;
+    }
+
+    template<class V, type_if<int, is_constructible_v<T, V&&>> = 0>
+    void push_back(V&& value) { emplace_back(static_cast<V&&>(value)); }
+
+    template<class V, type_if<int, is_constructible_v<T, V&&>> = 0>
+    void push_front(V&& value) { emplace_front(static_cast<V&&>(value)); }
+
+    void pop_back() noexcept {
+        size_t const pos = m_offset + --m_size;
+        _at(pos).~T();
+        if (pos % N == 0 || m_size == 0) _release(pos / N);
+    }
+
+    void pop_front() noexcept {
+        size_t const pos = m_offset++;
+        --m_size;
+        _at(pos).~T();
+        if (pos % N == N - 1 || m_size == 0) _release(pos / N);
+    }
+
+    /**
+    * the chunks go to the pool
+    */
+    void clear() noexcept {
+        foreach([](T& value) { value.~T(); });
+        if (m_size) {
+            for (size_t c = m_offset / N, last = (m_offset + m_size - 1) / N; c <= last; ++c) _release(c);
+        }
+        m_size = 0;
+        m_offset = m_map_size / 2 * N;
+    }
+
+    /**
+    * frees the pooled chunks
+    */
+    void shrink_to_fit() noexcept {
+        while (m_pool) {
+            _chunk* const next = m_pool->next;
+            delete m_pool;
+            m_pool = next;
+        }
+    }
+
+    /**
+    * visits the elements front to back, one contiguous run per chunk
+    */
+    template<class Proc, class... Args>
+    type_if<size_type, util::invocable_v<Proc, reference, Args...>> foreach(Proc&& proc, Args&&... args) {
+        return _foreach(*this, proc, args...);
+    }
+
+    template<class Proc, class... Args>
+    type_if<size_type, util::invocable_v<Proc, const_reference, Args...>> foreach(Proc&& proc, Args&&... args) const {
+        return _foreach(*this, proc, args...);
+    }
+
+    template<class Proc, class... Args>
+    type_if<size_type, util::invocable_v<Proc, reference, Args...>> rforeach(Proc&& proc, Args&&... args) {
+        return _rforeach(*this, proc, args...);
+    }
+
+    template<class Proc, class... Args>
+    type_if<size_type, util::invocable_v<Proc, const_reference, Args...>> rforeach(Proc&& proc, Args&&... args) const {
+        return _rforeach(*this, proc, args...);
+    }
+
+    /**
+    * hands each chunk's run of elements over at once, for loops the compiler can vectorize
+    * @param [] proc - invoked as proc(T* first, size_t count)
+    */
+    template<class Proc>
+    type_if<size_type, util::invocable_v<Proc&, T*, size_t>> foreach_chunk(Proc&& proc) {
+        return _foreach_chunk(*this, proc);
+    }
+
+    template<class Proc>
+    type_if<size_type, util::invocable_v<Proc&, T const*, size_t>> foreach_chunk(Proc&& proc) const {
+        return _foreach_chunk(*this, proc);
+    }
+
+protected:
+    /**
+    * room for N elements constructed one by one; the link is used only while pooled
+    */
+    union _chunk {
+        _chunk() noexcept : next(nullptr) {}
+        ~_chunk() noexcept {}
+
+        _chunk* next;
+        T elems[N];
+    };
+
+    /**
+    * the chunk holding position p is m_map[p / N]; positions run from m_offset to m_offset + m_size
+    */
+    _chunk** m_map;
+    size_t m_map_size;
+    size_t m_offset;
+    size_t m_size;
+    _chunk* m_pool;
+
+    _NODISCARD T& _at(size_t const pos) const noexcept { return m_map[pos / N]->elems[pos % N]; }
+
+    /**
+    * the storage for position pos, taking a chunk if there is none yet
+    */
+    T* _slot(size_t const pos) {
+        _chunk*& chunk = m_map[pos / N];
+        if (!chunk) {
+            if (m_pool) {
+                chunk = m_pool;
+                m_pool = m_pool->next;
+            }
+            else chunk = new _chunk;
+        }
+        return chunk->elems + pos % N;
+    }
+
+    void _release(size_t const c) noexcept {
+        m_map[c]->next = m_pool;
+        m_pool = m_map[c];
+        m_map[c] = nullptr;
+    }
+
+    /**
+    * recenters the chunks in use so both ends have room, doubling the map unless they fill less than half of it
+    */
+    void _grow_map() {
+        size_t const first = m_offset / N;
+        size_t const used = m_size ? (m_offset + m_size - 1) / N - first + 1 : 0;
+        size_t const size = used * 2 + 2 <= m_map_size ? m_map_size : m_map_size ? m_map_size * 2 : 8;
+        _chunk** const map = new _chunk*[size]();
+        size_t const start = (size - used) / 2;
+        if (used) std::memcpy(map + start, m_map + first, used * sizeof(_chunk*));
+        delete[] m_map;
+        m_map = map;
+        m_map_size = size;
+        m_offset = start * N + m_offset % N;
+    }
+
+    void _check(size_type const pos) const {
+        if (pos >= m_size)
+            std::_Xout_of_range("segmented_deque::at");
+    }
+
+    template<class Self, class Proc> static size_t _foreach_chunk(Self& self, Proc& proc) {
+        for (size_t done = 0; done != self.m_size; ) {
+            size_t const pos = self.m_offset + done;
+            size_t const count = N - pos % N < self.m_size - done ? N - pos % N : self.m_size - done;
+            util::invoke(proc, &self[done], count);
+            done += count;
+        }
+        return self.m_size;
+    }
+
+    template<class Self, class Proc, class... Args> static size_t _foreach(Self& self, Proc& proc, Args&... args) {
+        for (size_t done = 0; done != self.m_size; ) {
+            size_t const pos = self.m_offset + done;
+            size_t const count = N - pos % N < self.m_size - done ? N - pos % N : self.m_size - done;
+            auto const first = &self[done];
+            for (size_t i = 0; i != count; ++i) util::invoke(proc, first[i], args...);
+            done += count;
+        }
+        return self.m_size;
+    }
+
+    template<class Self, class Proc, class... Args> static size_t _rforeach(Self& self, Proc& proc, Args&... args) {
+        for (size_t left = self.m_size; left != 0; ) {
+            size_t const pos = self.m_offset + left - 1;
+            size_t const count = pos % N + 1 < left ? pos % N + 1 : left;
+            auto const last = &self[left - 1];
+            for (size_t i = 0; i != count; ++i) util::invoke(proc, *(last - i), args...);
+            left -= count;
+        }
+        return self.m_size;
+    }
+};
+
+#endif // !__SEGMENTED_DEQUE_HPP
@@ -0,0 +1,149 @@
+#ifndef __SOA_ARRAY_HPP
+#define __SOA_ARRAY_HPP 1
+
+#include "util.hpp"
+#include "object.hpp"
+#include "pair.hpp"
+#include "array.hpp"
+#include <tuple>
+
+template<class Record, class = make_index_sequence<Record>> struct soa_array;
+
+/**
+* stands for the record at a position of a soa_array: the fields are reached with get<I>(),
+* converts to the record and, unless Const, accepts records
+*/
+template<class Record, bool Const> struct soa_reference {
+    using soa = conditional<Const, soa_array<Record> const, soa_array<Record>>;
+
+    constexpr soa_reference(soa& owner, size_t const pos) noexcept : m_owner(&owner), m_pos(pos) {}
+
+    template<size_t I> _NODISCARD auto& get() const noexcept { return m_owner->template field<I>()[m_pos]; }
+
+    _NODISCARD operator Record() const { return _record(make_index_sequence<Record>{}); }
+
+    template<bool C = Const, type_if<int, !C> = 0>
+    soa_reference const& operator=(Record const& record) const {
+        _assign(record, make_index_sequence<Record>{});
+        return *this;
+    }
+
+    template<bool C = Const, type_if<int, !C> = 0>
+    soa_reference const& operator=(soa_reference<Record, true> const& other) const {
+        return *this = Record(other);
+    }
+
+    /**
+    * assigns the record, never rebinds
+    */
+    soa_reference const& operator=(soa_reference const& other) const {
+        static_assert(!Const, "assignment through a const_reference");
+        return *this = Record(other);
+    }
+
+protected:
+    soa* m_owner;
+    size_t m_pos;
+
+    template<size_t... I> Record _record(std::index_sequence<I...>) const { return Record(get<I>()...); }
+
+    template<size_t... I> void _assign(Record const& record, std::index_sequence<I...>) const {
+        int const assigned[] = { (void(get<I>() = std::get<I>(record)), 0)... };
+        (void)assigned;
+    }
+};
+
+/**
+* structure of arrays: each field of the tuple-like Record (pair or anything with tuple_size, tuple_element and get)
+* lives in its own contiguous array, so a scan over one field touches no other
+*/
+template<class Record, size_t... I> struct soa_array<Record, std::index_sequence<I...>> {
+    template<size_t K> using field_type = tuple_element_t<K, Record>;
+
+    using value_type = Record;
+    using size_type = size_t;
+    using reference = soa_reference<Record, false>;
+    using const_reference = soa_reference<Record, true>;
+
+    constexpr _INLINE_VAR static size_t fields = sizeof...(I);
+
+    soa_array() noexcept : m_fields(), m_size(0) {}
+
+    /**
+    * value-initializes n records
+    */
+    explicit soa_array(size_type const n) : m_fields(array<field_type<I>>(n)...), m_size(n) {}
+
+    /**
+    * splits the records field by field
+    */
+    explicit soa_array(array<Record> const& records) : m_fields(records.map(_field<I>{})...), m_size(records.size()) {}
+
+    _NODISCARD size_type size() const noexcept { return m_size; }
+
+    _NODISCARD bool empty() const noexcept { return m_size == 0; }
+
+    /**
+    * the contiguous array of the K-th field of every record
+    */
+    template<size_t K> _NODISCARD array<field_type<K>>& field() noexcept { return std::get<K>(m_fields); }
+
+    template<size_t K> _NODISCARD array<field_type<K>> const& field() const noexcept { return std::get<K>(m_fields); }
+
+    _NODISCARD reference operator[](size_type const pos) noexcept { return { *this, pos }; }
+
+    _NODISCARD const_reference operator[](size_type const pos) const noexcept { return { *this, pos }; }
+
+    _NODISCARD reference at(size_type const pos) {
+        _check(pos);
+        return { *this, pos };
+    }
+
+    _NODISCARD const_reference at(size_type const pos) const {
+        _check(pos);
+        return { *this, pos };
+    }
+
+    template<class Proc>
+    type_if<size_type, util::invocable_v<Proc&, reference>> foreach(Proc&& proc) {
+        for (size_type i = 0; i != m_size; ++i) util::invoke(proc, reference{ *this, i });
+        return m_size;
+    }
+
+    template<class Proc>
+    type_if<size_type, util::invocable_v<Proc&, const_reference>> foreach(Proc&& proc) const {
+        for (size_type i = 0; i != m_size; ++i) util::invoke(proc, const_reference{ *this, i });
+        return m_size;
+    }
+
+    /**
+    * reassembles the records
+    */
+    _NODISCARD array<Record> to_array() const { return arrays::collect(*this); }
+
+protected:
+    std::tuple<array<field_type<I>>...> m_fields;
+    size_type m_size;
+
+    template<size_t K> struct _field {
+        field_type<K> operator()(Record const& record) const { return std::get<K>(record); }
+    };
+
+    void _check(size_type const pos) const {
+        if (pos >= m_size)
+            std::_Xout_of_range("soa_array::at");
+    }
+};
+
+namespace std
+{
+    template<class Record, bool Const>
+    struct tuple_size<::soa_reference<Record, Const>> : tuple_size<Record> {};
+
+    template<size_t I, class Record, bool Const>
+    struct tuple_element<I, ::soa_reference<Record, Const>> {
+        using type = ::conditional<Const, ::tuple_element_t<I, Record> const&, ::tuple_element_t<I, Record>&>;
+    };
+}
+
+#endif // !__SOA_ARRAY_HPP
@@ -0,0 +1,248 @@
+#ifndef __SPARSE_ARRAY_HPP
+#define __SPARSE_ARRAY_HPP 1
+
+#include "util.hpp"
+#include "object.hpp"
+#include "array.hpp"
+#include "optional.hpp"
+#include "algorithm.hpp"
+#include "bit_array.hpp"
+#include <utility>
+
+/**
+* a mostly empty array of a fixed size: a presence bit per index, the count of present entries before each word of bits,
+* and the present values packed in index order. Reading an index is O(1): its value is at the rank of its bit.
+* Filling an empty index moves the values after it, O(count)
+*/
+template<class T> struct sparse_array {
+    using value_type = T;
+    using size_type = size_t;
+    using reference = T&;
+    using const_reference = T const&;
+
+    sparse_array() noexcept : m_words(), m_ranks(), m_values(), m_size(0), m_count(0) {}
+
+    /**
+    * n empty indices
+    */
+    explicit sparse_array(size_type const n) : m_words(bits::words(n)), m_ranks(bits::words(n)), m_values(), m_size(n), m_count(0) {}
+
+    explicit sparse_array(array<optional<T>> const& dense)
+        : m_words(bits::words(dense.size())), m_ranks(bits::words(dense.size())), m_values(), m_size(dense.size()), m_count(0) {
+        optional<T> const* const data = dense.data();
+        size_t count = 0;
+        for (size_t i = 0; i != m_size; ++i) count += data[i].has_value();
+        array<T> values{ arrays::for_overwrite, count };
+        for (size_t i = 0; i != m_size; ++i) {
+            if (!data[i]) continue;
+            m_words.data()[i / bits::word_bits] |= bits::word(1) << (i % bits::word_bits);
+            values.data()[m_count++] = *data[i];
+        }
+        m_values.swap(values);
+        _rerank(0);
+    }
+
+    sparse_array(sparse_array const& other)
+        : m_words(other.m_words), m_ranks(other.m_ranks), m_values(other.m_values), m_size(other.m_size), m_count(other.m_count) {
+    }
+
+    sparse_array(sparse_array&& other) noexcept
+        : m_words(static_cast<array<bits::word>&&>(other.m_words)), m_ranks(static_cast<array<size_t>&&>(other.m_ranks)),
+        m_values(static_cast<array<T>&&>(other.m_values)), m_size(other.m_size), m_count(other.m_count) {
+        other.m_size = 0;
+        other.m_count = 0;
+    }
+
+    sparse_array& operator=(sparse_array other) noexcept {
+        swap(other);
+        return *this;
+    }
+
+    void swap(sparse_array& other) noexcept {
+        m_words.swap(other.m_words);
+        m_ranks.swap(other.m_ranks);
+        m_values.swap(other.m_values);
+        std::swap(m_size, other.m_size);
+        std::swap(m_count, other.m_count);
+    }
+
+    /**
+    * the count of indices, present or not
+    */
+    _NODISCARD size_type size() const noexcept { return m_size; }
+
+    /**
+    * the count of present entries
+    */
+    _NODISCARD size_type count() const noexcept { return m_count; }
+
+    _NODISCARD bool empty() const noexcept { return m_size == 0; }
+
+    _NODISCARD bool contains(size_type const pos) const noexcept {
+        return pos < m_size && ((m_words.data()[pos / bits::word_bits] >> (pos % bits::word_bits)) & 1);
+    }
+
+    /**
+    * @return nullptr if absent
+    */
+    _NODISCARD T* find(size_type const pos) noexcept { return contains(pos) ? m_values.data() + _rank(pos) : nullptr; }
+
+    _NODISCARD T const* find(size_type const pos) const noexcept { return contains(pos) ? m_values.data() + _rank(pos) : nullptr; }
+
+    /**
+    * @param [] pos - present
+    */
+    _NODISCARD reference operator[](size_type const pos) noexcept { return m_values.data()[_rank(pos)]; }
+
+    _NODISCARD const_reference operator[](size_type const pos) const noexcept { return m_values.data()[_rank(pos)]; }
+
+    _NODISCARD reference at(size_type const pos) {
+        if (!contains(pos))
+            std::_Xout_of_range("sparse_array::at");
+        return m_values.data()[_rank(pos)];
+    }
+
+    _NODISCARD const_reference at(size_type const pos) const {
+        if (!contains(pos))
+            std::_Xout_of_range("sparse_array::at");
+        return m_values.data()[_rank(pos)];
+    }
+
+    /**
+    * the present values in index order
+    */
+    _NODISCARD T* values() noexcept { return m_values.data(); }
+
+    _NODISCARD T const* values() const noexcept { return m_values.data(); }
+
+    /**
+    * assigns the value at pos, filling it if empty
+    * @param [] pos - less than size()
+    */
+    template<class V, type_if<int, is_assignable_v<T&, V&&>> = 0>
+    reference set(size_type const pos, V&& value) {
+        size_t const rank = _rank(pos);
+        if (contains(pos)) return m_values.data()[rank] = static_cast<V&&>(value);
+        if (m_count == m_values.size()) _grow();
+        T* const data = m_values.data();
+        for (size_t i = m_count; i != rank; --i) data[i] = static_cast<T&&>(data[i - 1]);
+        data[rank] = static_cast<V&&>(value);
+        ++m_count;
+        m_words.data()[pos / bits::word_bits] |= bits::word(1) << (pos % bits::word_bits);
+        _shift_ranks(pos, 1);
+        return data[rank];
+    }
+
+    /**
+    * empties pos
+    * @return false if already empty
+    */
+    bool reset(size_type const pos) {
+        if (!contains(pos)) return false;
+        T* const data = m_values.data();
+        for (size_t i = _rank(pos) + 1; i != m_count; ++i) data[i - 1] = static_cast<T&&>(data[i]);
+        data[--m_count] = T();
+        m_words.data()[pos / bits::word_bits] &= ~(bits::word(1) << (pos % bits::word_bits));
+        _shift_ranks(pos, size_t(-1));
+        return true;
+    }
+
+    /**
+    * empties every index, keeping the size
+    */
+    void clear() {
+        size_t const n = bits::words(m_size);
+        for (size_t i = 0; i != n; ++i) {
+            m_words.data()[i] = 0;
+            m_ranks.data()[i] = 0;
+        }
+        array<T> values;
+        m_values.swap(values);
+        m_count = 0;
+    }
+
+    /**
+    * visits the present entries in index order
+    * @param [] proc - invoked as proc(index, value)
+    */
+    template<class Proc>
+    type_if<size_type, util::invocable_v<Proc&, size_t, reference>> foreach(Proc&& proc) {
+        return _foreach(*this, proc);
+    }
+
+    template<class Proc>
+    type_if<size_type, util::invocable_v<Proc&, size_t, const_reference>> foreach(Proc&& proc) const {
+        return _foreach(*this, proc);
+    }
+
+    /**
+    * the dense form, empty where absent
+    */
+    _NODISCARD array<optional<T>> to_array() const {
+        array<optional<T>> res(m_size);
+        optional<T>* const data = res.data();
+        foreach([data](size_t const pos, T const& value) { data[pos] = optional<T>(value); });
+        return res;
+    }
+
+protected:
+    array<bits::word> m_words;
+    /**
+    * the count of set bits in the words before each
+    */
+    array<size_t> m_ranks;
+    /**
+    * the slots past m_count hold default values
+    */
+    array<T> m_values;
+    size_t m_size;
+    size_t m_count;
+
+    _NODISCARD size_t _rank(size_t const pos) const noexcept {
+        size_t const w = pos / bits::word_bits;
+        bits::word const below = (bits::word(1) << (pos % bits::word_bits)) - 1;
+        return m_ranks.data()[w] + size_t(algorithms::popcount(m_words.data()[w] & below));
+    }
+
+    /**
+    * recounts the ranks from word w on
+    */
+    void _rerank(size_t w) noexcept {
+        size_t const n = bits::words(m_size);
+        size_t rank = w ? m_ranks.data()[w - 1] + size_t(algorithms::popcount(m_words.data()[w - 1])) : 0;
+        for (; w != n; ++w) {
+            m_ranks.data()[w] = rank;
+            rank += size_t(algorithms::popcount(m_words.data()[w]));
+        }
+    }
+
+    /**
+    * adds delta, wrapping, to the ranks of the words after the one of pos
+    */
+    void _shift_ranks(size_t const pos, size_t const delta) noexcept {
+        size_t const n = bits::words(m_size);
+        for (size_t w = pos / bits::word_bits + 1; w < n; ++w) m_ranks.data()[w] += delta;
+    }
+
+    void _grow() {
+        size_t const capacity = m_count ? m_count * 2 : 8;
+        array<T> values(capacity);
+        for (size_t i = 0; i != m_count; ++i) values.data()[i] = static_cast<T&&>(m_values.data()[i]);
+        m_values.swap(values);
+    }
+
+    template<class Self, class Proc> static size_t _foreach(Self& self, Proc& proc) {
+        size_t const n = bits::words(self.m_size);
+        bits::word const* const words = self.m_words.data();
+        auto* const values = self.m_values.data();
+        size_t rank = 0;
+        for (size_t w = 0; w != n; ++w) {
+            for (bits::word set = words[w]; set; set &= set - 1) {
+                util::invoke(proc, w * bits::word_bits + size_t(algorithms::countr_zero(set)), values[rank++]);
+            }
+        }
+        return self.m_count;
+    }
+};
+
+#endif // !__SPARSE_ARRAY_HPP
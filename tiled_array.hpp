@@ -0,0 +1,138 @@
+#ifndef __TILED_ARRAY_HPP
+#define __TILED_ARRAY_HPP 1
+
+#include "util.hpp"
+#include "object.hpp"
+#include "algorithm.hpp"
+#include "array.hpp"
+
+/**
+* N x M matrix stored as Tile x Tile blocks laid out row by row, each block row-major,
+* so that walking a row or a column touches one block per Tile elements
+* @param [] Tile - the side of a block, a power of two
+*/
+template<class T, size_t N, size_t M, size_t Tile = algorithms::tile_v<T>> struct tiled_array {
+    static_assert(N != 0, "N == 0");
+    static_assert(M != 0, "M == 0");
+    static_assert(Tile != 0 && (Tile & (Tile - 1)) == 0, "Tile is not a power of two");
+
+    using value_type = T;
+    using size_type = size_t;
+    using reference = T&;
+    using const_reference = T const&;
+
+    constexpr _INLINE_VAR static size_t tile = Tile;
+
+    constexpr tiled_array() = default;
+
+    template<class U, type_if<int, is_assignable_v<T&, U const&>> = 0>
+    explicit tiled_array(array<U, N, M> const& arr) {
+        for (size_t x = 0; x != N; ++x) {
+            for (size_t y = 0; y != M; ++y) (*this)(x, y) = arr[x][y];
+        }
+    }
+
+    _NODISCARD constexpr static size_type rows() noexcept { return N; }
+
+    _NODISCARD constexpr static size_type cols() noexcept { return M; }
+
+    _NODISCARD constexpr static size_type size() noexcept { return N * M; }
+
+    _NODISCARD constexpr reference operator()(size_type x, size_type y) noexcept { return m_elems[_index(x, y)]; }
+
+    _NODISCARD constexpr const_reference operator()(size_type x, size_type y) const noexcept { return m_elems[_index(x, y)]; }
+
+    _NODISCARD constexpr reference at(size_type x, size_type y) {
+        _check(x, y);
+        return m_elems[_index(x, y)];
+    }
+
+    _NODISCARD constexpr const_reference at(size_type x, size_type y) const {
+        _check(x, y);
+        return m_elems[_index(x, y)];
+    }
+
+    /**
+    * visits the elements block by block, in storage order
+    */
+    template<class Proc, class... Args>
+    constexpr type_if<size_type, util::invocable_v<Proc&, reference, Args&...>> foreach(Proc&& proc, Args&&... args) {
+        auto visit = [&proc, &args...](size_t, size_t, reference elem) { util::invoke(proc, elem, args...); };
+        return _foreach(*this, visit);
+    }
+
+    template<class Proc, class... Args>
+    constexpr type_if<size_type, util::invocable_v<Proc&, const_reference, Args&...>> foreach(Proc&& proc, Args&&... args) const {
+        auto visit = [&proc, &args...](size_t, size_t, const_reference elem) { util::invoke(proc, elem, args...); };
+        return _foreach(*this, visit);
+    }
+
+    /**
+    * foreach with the position of each element
+    * @param [] proc - invoked as proc(x, y, elem)
+    */
+    template<class Proc>
+    constexpr type_if<size_type, util::invocable_v<Proc&, size_t, size_t, reference>> foreach_indexed(Proc&& proc) {
+        return _foreach(*this, proc);
+    }
+
+    template<class Proc>
+    constexpr type_if<size_type, util::invocable_v<Proc&, size_t, size_t, const_reference>> foreach_indexed(Proc&& proc) const {
+        return _foreach(*this, proc);
+    }
+
+    /**
+    * blocks are transposed one by one, each staying cached while it is rewritten
+    */
+    _NODISCARD tiled_array<T, M, N, Tile> transposed() const {
+        tiled_array<T, M, N, Tile> res;
+        for (size_t bx = 0; bx != _tiles_n; ++bx) {
+            for (size_t by = 0; by != _tiles_m; ++by) {
+                algorithms::transpose(m_elems.data() + (bx * _tiles_m + by) * _block, Tile, Tile, ptrdiff_t(Tile),
+                    res.m_elems.data() + (by * res._tiles_m + bx) * _block, ptrdiff_t(Tile));
+            }
+        }
+        return res;
+    }
+
+    _NODISCARD array<T, N, M> to_array() const {
+        array<T, N, M> res;
+        foreach_indexed([&res](size_t const x, size_t const y, const_reference elem) { res[x][y] = elem; });
+        return res;
+    }
+
+protected:
+    constexpr _INLINE_VAR static size_t _tiles_n = (N + Tile - 1) / Tile;
+    constexpr _INLINE_VAR static size_t _tiles_m = (M + Tile - 1) / Tile;
+    constexpr _INLINE_VAR static size_t _block = Tile * Tile;
+
+    array<T, _tiles_n * _tiles_m * _block> m_elems;
+
+    _NODISCARD constexpr static size_t _index(size_t const x, size_t const y) noexcept {
+        return (x / Tile * _tiles_m + y / Tile) * _block + x % Tile * Tile + y % Tile;
+    }
+
+    constexpr static void _check(size_t const x, size_t const y) {
+        if (x >= N || y >= M)
+            std::_Xout_of_range("tiled_array::at");
+    }
+
+    template<class Self, class Proc> constexpr static size_type _foreach(Self& self, Proc& proc) {
+        for (size_t bx = 0; bx != _tiles_n; ++bx) {
+            size_t const x1 = N - bx * Tile < Tile ? N : bx * Tile + Tile;
+            for (size_t by = 0; by != _tiles_m; ++by) {
+                size_t const y1 = M - by * Tile < Tile ? M : by * Tile + Tile;
+                auto* const block = self.m_elems.data() + (bx * _tiles_m + by) * _block;
+                for (size_t x = bx * Tile; x != x1; ++x) {
+                    auto* const row = block + x % Tile * Tile;
+                    for (size_t y = by * Tile; y != y1; ++y) util::invoke(proc, x, y, row[y % Tile]);
+                }
+            }
+        }
+        return size();
+    }
+
+    template<class, size_t, size_t, size_t> friend struct tiled_array;
+};
+
+#endif // !__TILED_ARRAY_HPP
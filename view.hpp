@@ -0,0 +1,326 @@
+#ifndef __VIEW_HPP
+#define __VIEW_HPP 1
+
+#include "util.hpp"
+#include "object.hpp"
+#include "container.hpp"
+#include "pair.hpp"
+#include "array.hpp"
+
+template<class Derived = void> struct view;
+
+using views = view<>;
+
+/**
+* lazy views: every stage pushes its elements into a sink (returning false to stop),
+* so a pipeline runs as a single loop over the source and allocates nothing until materialized
+*/
+template<> struct view<void> {
+protected:
+    template<class C> static sfinae<decltype(*container::begin(std::declval<C&>()))> _reference(int);
+    template<class C> static sfinae<typename C::value_type const&> _reference(long);
+
+    template<class C> using _reference_t = typename decltype(_reference<C>(0))::result_type;
+
+    template<class C, bool = container::iterable_v<C&>> struct _visit {
+        template<class Sink> static void each(C& c, Sink& sink) {
+            for (auto i = container::begin(c), end = container::end(c); i != end; ++i) {
+                if (!sink(*i)) return;
+            }
+        }
+    };
+
+    /**
+    * not iterable: the container drives the loop, the rest is skipped once the sink stops
+    */
+    template<class C> struct _visit<C, false> {
+        template<class Sink> static void each(C& c, Sink& sink) {
+            bool go = true;
+            container::foreach(c, [&go, &sink](auto&& value) {
+                if (go) go = sink(static_cast<decltype(value)&&>(value));
+            });
+        }
+    };
+
+    template<class C, bool = container::reverse_iterable_v<C&>> struct _rvisit {
+        template<class Sink> static void each(C& c, Sink& sink) {
+            for (auto i = container::rbegin(c), rend = container::rend(c); i != rend; ++i) {
+                if (!sink(*i)) return;
+            }
+        }
+    };
+
+    template<class C> struct _rvisit<C, false> {
+        template<class Sink> static void each(C& c, Sink& sink) {
+            bool go = true;
+            container::rforeach(c, [&go, &sink](auto&& value) {
+                if (go) go = sink(static_cast<decltype(value)&&>(value));
+            });
+        }
+    };
+
+    template<class V> using _size_t = decltype(std::declval<V const&>().size());
+
+public:
+    template<class C> struct _all : view<_all<C>> {
+        using reference = _reference_t<C>;
+        using value_type = remove_cvref_t<reference>;
+
+        constexpr explicit _all(C& c) noexcept : m_c(&c) {}
+
+        template<class Sink> void _each(Sink& sink) const { _visit<C>::each(*m_c, sink); }
+
+        template<class Sink, class D = C> auto _reach(Sink& sink) const
+            -> decltype(void(container::rforeach(std::declval<D&>(), std::declval<void(&)(_reference_t<D>)>()))) {
+            _rvisit<C>::each(*m_c, sink);
+        }
+
+        template<class D = C> auto size() const -> decltype(container::size(std::declval<D&>())) { return container::size(*m_c); }
+
+    protected:
+        C* m_c;
+    };
+
+    template<class V, class F> struct _map : view<_map<V, F>> {
+        using reference = util::invoke_result_t<F const&, typename V::reference>;
+        using value_type = remove_cvref_t<reference>;
+
+        constexpr _map(V v, F f) : m_v(static_cast<V&&>(v)), m_f(static_cast<F&&>(f)) {}
+
+        template<class Sink> void _each(Sink& sink) const {
+            auto mapped = [this, &sink](auto&& value) { return sink(util::invoke(m_f, static_cast<decltype(value)&&>(value))); };
+            m_v._each(mapped);
+        }
+
+        template<class Sink, class D = V> auto _reach(Sink& sink) const -> decltype(std::declval<D const&>()._reach(sink)) {
+            auto mapped = [this, &sink](auto&& value) { return sink(util::invoke(m_f, static_cast<decltype(value)&&>(value))); };
+            m_v._reach(mapped);
+        }
+
+        template<class D = V> _size_t<D> size() const { return m_v.size(); }
+
+    protected:
+        V m_v;
+        F m_f;
+    };
+
+    template<class V, class Filter> struct _filter : view<_filter<V, Filter>> {
+        using reference = typename V::reference;
+        using value_type = typename V::value_type;
+
+        constexpr _filter(V v, Filter filter) : m_v(static_cast<V&&>(v)), m_filter(static_cast<Filter&&>(filter)) {}
+
+        template<class Sink> void _each(Sink& sink) const {
+            auto filtered = [this, &sink](auto&& value) { return util::invoke(m_filter, value) ? sink(static_cast<decltype(value)&&>(value)) : true; };
+            m_v._each(filtered);
+        }
+
+        template<class Sink, class D = V> auto _reach(Sink& sink) const -> decltype(std::declval<D const&>()._reach(sink)) {
+            auto filtered = [this, &sink](auto&& value) { return util::invoke(m_filter, value) ? sink(static_cast<decltype(value)&&>(value)) : true; };
+            m_v._reach(filtered);
+        }
+
+    protected:
+        V m_v;
+        Filter m_filter;
+    };
+
+    template<class V> struct _take : view<_take<V>> {
+        using reference = typename V::reference;
+        using value_type = typename V::value_type;
+
+        constexpr _take(V v, size_t const count) : m_v(static_cast<V&&>(v)), m_count(count) {}
+
+        template<class Sink> void _each(Sink& sink) const {
+            size_t left = m_count;
+            if (left == 0) return;
+            auto taken = [&left, &sink](auto&& value) { return sink(static_cast<decltype(value)&&>(value)) && --left != 0; };
+            m_v._each(taken);
+        }
+
+        template<class D = V> _size_t<D> size() const {
+            auto const size = m_v.size();
+            return size < m_count ? size : m_count;
+        }
+
+    protected:
+        V m_v;
+        size_t m_count;
+    };
+
+    template<class V> struct _drop : view<_drop<V>> {
+        using reference = typename V::reference;
+        using value_type = typename V::value_type;
+
+        constexpr _drop(V v, size_t const count) : m_v(static_cast<V&&>(v)), m_count(count) {}
+
+        template<class Sink> void _each(Sink& sink) const {
+            size_t skip = m_count;
+            auto dropped = [&skip, &sink](auto&& value) {
+                if (skip == 0) return sink(static_cast<decltype(value)&&>(value));
+                --skip;
+                return true;
+            };
+            m_v._each(dropped);
+        }
+
+        template<class D = V> _size_t<D> size() const {
+            auto const size = m_v.size();
+            return size > m_count ? size - m_count : 0;
+        }
+
+    protected:
+        V m_v;
+        size_t m_count;
+    };
+
+    template<class V> struct _reverse : view<_reverse<V>> {
+        using reference = typename V::reference;
+        using value_type = typename V::value_type;
+
+        constexpr explicit _reverse(V v) : m_v(static_cast<V&&>(v)) {}
+
+        template<class Sink> void _each(Sink& sink) const { m_v._reach(sink); }
+
+        template<class Sink, class D = V> auto _reach(Sink& sink) const -> decltype(std::declval<D const&>()._each(sink)) { m_v._each(sink); }
+
+        template<class D = V> _size_t<D> size() const { return m_v.size(); }
+
+    protected:
+        V m_v;
+    };
+
+    template<class V> struct _enumerate : view<_enumerate<V>> {
+        using reference = pair<size_t, typename V::reference>;
+        using value_type = pair<size_t, typename V::value_type>;
+
+        constexpr explicit _enumerate(V v) : m_v(static_cast<V&&>(v)) {}
+
+        template<class Sink> void _each(Sink& sink) const {
+            size_t index = 0;
+            auto enumerated = [&index, &sink](auto&& value) { return sink(reference{ index++, static_cast<decltype(value)&&>(value) }); };
+            m_v._each(enumerated);
+        }
+
+        template<class D = V> _size_t<D> size() const { return m_v.size(); }
+
+    protected:
+        V m_v;
+    };
+
+    /**
+    * the view drives the loop, the container is advanced alongside; stops at the shorter of both
+    */
+    template<class V, class C> struct _zip : view<_zip<V, C>> {
+        using reference = pair<typename V::reference, _reference_t<C>>;
+        using value_type = pair<typename V::value_type, remove_cvref_t<_reference_t<C>>>;
+
+        constexpr _zip(V v, C& c) : m_v(static_cast<V&&>(v)), m_c(&c) {}
+
+        template<class Sink> void _each(Sink& sink) const {
+            auto i = container::begin(*m_c);
+            auto const end = container::end(*m_c);
+            if (i == end) return;
+            auto zipped = [&i, &end, &sink](auto&& value) {
+                auto&& other = *i;
+                return sink(reference{ static_cast<decltype(value)&&>(value), static_cast<decltype(other)&&>(other) }) && ++i != end;
+            };
+            m_v._each(zipped);
+        }
+
+        template<class D = V, class = decltype(container::size(std::declval<C&>()))> _size_t<D> size() const {
+            auto const size = m_v.size();
+            auto const other = container::size(*m_c);
+            return size < other ? size : other;
+        }
+
+    protected:
+        V m_v;
+        C* m_c;
+    };
+
+    /**
+    * @param [ref] c - foreachable or iterable, must outlive the view
+    */
+    template<class C> _NODISCARD constexpr static _all<C> all(C& c) noexcept { return _all<C>{ c }; }
+
+    template<class C> _NODISCARD constexpr static _reverse<_all<C>> reverse(C& c) noexcept { return _reverse<_all<C>>{ _all<C>{ c } }; }
+};
+
+/**
+* the pipeline members of every view
+*/
+template<class Derived> struct view {
+    using size_type = size_t;
+
+    template<class F>
+    _NODISCARD views::_map<Derived, remove_cvref_t<F>> map(F&& f) const { return { _derived(), static_cast<F&&>(f) }; }
+
+    template<class Filter>
+    _NODISCARD views::_filter<Derived, remove_cvref_t<Filter>> filter(Filter&& filter) const { return { _derived(), static_cast<Filter&&>(filter) }; }
+
+    _NODISCARD views::_take<Derived> take(size_t const count) const { return { _derived(), count }; }
+
+    _NODISCARD views::_drop<Derived> drop(size_t const count) const { return { _derived(), count }; }
+
+    /**
+    * the stages below have to be reversible: sources, map and filter
+    */
+    _NODISCARD views::_reverse<Derived> reverse() const { return views::_reverse<Derived>{ _derived() }; }
+
+    _NODISCARD views::_enumerate<Derived> enumerate() const { return views::_enumerate<Derived>{ _derived() }; }
+
+    /**
+    * @param [ref] c - iterable, must outlive the view
+    */
+    template<class C, type_if<int, container::iterable_v<C&>> = 0>
+    _NODISCARD views::_zip<Derived, C> zip(C& c) const { return { _derived(), c }; }
+
+    template<class Proc>
+    size_type foreach(Proc&& proc) const {
+        size_type res = 0;
+        auto sink = [&res, &proc](auto&& value) {
+            util::invoke(proc, static_cast<decltype(value)&&>(value));
+            ++res;
+            return true;
+        };
+        static_cast<Derived const&>(*this)._each(sink);
+        return res;
+    }
+
+    template<class Proc, class D = Derived>
+    auto rforeach(Proc&& proc) const -> decltype(std::declval<D const&>()._reach(std::declval<void(&)(int)>()), size_type()) {
+        size_type res = 0;
+        auto sink = [&res, &proc](auto&& value) {
+            util::invoke(proc, static_cast<decltype(value)&&>(value));
+            ++res;
+            return true;
+        };
+        static_cast<Derived const&>(*this)._reach(sink);
+        return res;
+    }
+
+    template<class Init, class Op>
+    _NODISCARD Init reduce(Init init, Op&& op) const {
+        auto sink = [&init, &op](auto&& value) {
+            init = util::invoke(op, static_cast<Init&&>(init), static_cast<decltype(value)&&>(value));
+            return true;
+        };
+        static_cast<Derived const&>(*this)._each(sink);
+        return init;
+    }
+
+    _NODISCARD size_type count() const {
+        return foreach([](auto&&) {});
+    }
+
+    /**
+    * materializes the view, in place for sized views
+    */
+    _NODISCARD auto to_array() const { return arrays::collect(static_cast<Derived const&>(*this)); }
+
+protected:
+    Derived _derived() const { return static_cast<Derived const&>(*this); }
+};
+
+#endif // !__VIEW_HPP